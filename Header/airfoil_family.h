@@ -0,0 +1,46 @@
+#ifndef AIRFOIL_FAMILY_H
+#define AIRFOIL_FAMILY_H
+
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+
+// Parametric airfoil families available in the generator
+enum FamilyType {
+    FamilyNaca4,        // NACA 4-digit: max camber [%], camber position [tenths], thickness [%]
+    FamilyNaca5,        // NACA 5-digit: design CL [x0.15], camber position [x0.05], reflex (0 or 1), thickness [%]
+    FamilyNaca6,        // NACA 6-series approximation: series, design CL [tenths], thickness [%]
+    FamilyCst           // CST: value of every upper surface coefficient, value of every lower surface coefficient
+};
+
+// Range of values of a family parameter (first, first + step, ..., up to last)
+struct ParameterRange {
+    double first;
+    double last;
+    double step;
+
+    size_t count() const;               // Number of values in the range
+    double value(size_t i) const;       // i-th value of the range
+};
+
+// Family of airfoils: every combination of the values of its parameters
+struct FamilySpec {
+    FamilyType type;
+    std::vector<ParameterRange> parameters;
+};
+
+// Function to read a family from command line arguments, e.g. "naca4 0:4:2 4 09:15:3" (returns false if not valid)
+bool parseFamilySpec(const std::vector<std::string>& arguments, FamilySpec& spec);
+
+// Function to get the number of members of a family (including the ones with non-valid parameters)
+size_t familySize(const FamilySpec& spec);
+
+// Function to generate the index-th member of a family, with points ordered as produced by processAirfoilPoints().
+// Members are generated one at a time, so families can be enumerated without storing them (false if not valid)
+bool generateFamilyMember(const FamilySpec& spec, size_t index, std::string& name, std::vector<Point>& points);
+
+// Function to simulate every member of a family, keeping the Pareto front of all their points
+void runFamilySweep(const FamilySpec& spec);
+
+#endif // AIRFOIL_FAMILY_H
@@ -0,0 +1,81 @@
+#ifndef AIRFOIL_SESSION_H
+#define AIRFOIL_SESSION_H
+
+#include "store_sim_results.h"
+#include "find_optimal_config.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdio>
+
+// Result of a session operation (errors are returned to the caller instead of terminating the program)
+enum SessionStatus {
+    SessionOk,                  // Operation completed successfully
+    SessionAirfoilNotFound,     // The airfoil coordinates file could not be opened
+    SessionInvalidAirfoil,      // Not enough coordinates to load the airfoil
+    SessionNoAirfoil,           // No airfoil loaded yet
+    SessionScratchFailed,       // The scratch directory could not be created or written
+    SessionSolverFailed,        // The xfoil process could not be started
+    SessionResultsNotFound,     // The polar file written by xfoil could not be opened
+    SessionConvergenceFailed,   // Convergence failed for every alpha value
+    SessionNoOptimum,           // No optimal configuration found (no simulation results available)
+    SessionOutputFailed         // The recap file could not be written
+};
+
+// Function to get a description of a session status, to be displayed to the user
+const char* describeSessionStatus(SessionStatus status);
+
+// Simulation parameters used by a session (each session has its own copy)
+struct SessionConfig {
+    int panelNodes;                 // Number of nodes along the airfoil's surface in xfoil (if no count was chosen for the airfoil)
+    int iterLimit;                  // Maximum number of iterations allowed in xfoil for each alpha
+    double alphaStart;              // Starting angle of attack
+    double alphaEnd;                // Ending angle of attack
+    double alphaIncrement;          // Increment of alpha at each iteration
+    double chord;                   // Airfoil chord                        [m]
+    double cruiseSpeed;             // Drone cruise speed                   [m/s]
+    double kinematicViscosity;      // Kinematic viscosity of the fluid     [m^2/s]
+
+    double reynoldsNumber() const;  // Reynolds number given by chord, cruise speed and kinematic viscosity
+};
+
+// Function to create a session configuration with the current values of the simulation parameters
+SessionConfig makeSessionConfig();
+
+// Self-contained analysis of an airfoil: it owns its configuration, xfoil process, results and scratch directory,
+// so that different sessions can run at the same time on different threads
+class AirfoilSession {
+public:
+    explicit AirfoilSession(const SessionConfig& sessionConfig);
+    ~AirfoilSession();
+
+    // Sessions own a process and a directory, so they cannot be copied
+    AirfoilSession(const AirfoilSession&) = delete;
+    AirfoilSession& operator=(const AirfoilSession&) = delete;
+
+    SessionStatus loadAirfoil(const std::string& airfoilFile);      // Read and format the airfoil (the original file is not modified)
+    SessionStatus runSimulation();                                  // Run the xfoil simulation and store its results
+    SessionStatus findOptimalConfig();                              // Build the Pareto front and find the optimal configuration
+    SessionStatus writeRecapFile(const std::string& recapFilename) const;  // Write the optimization recap file
+    SessionStatus analyze(const std::string& airfoilFile);          // Run all the previous steps (except the recap)
+
+    SessionConfig config;           // Simulation parameters (can be changed between simulations)
+
+    const std::string& airfoilName() const { return name; }
+    const std::string& scratchDirectory() const { return scratch; }
+    const PolarResult& results() const { return polar; }
+    const std::vector<std::pair<double, double>>& paretoFront() const { return front; }
+    const OptimalPoint& optimalPoint() const { return optimal; }
+
+private:
+    std::string scratch;                                // Directory storing the files exchanged with xfoil
+    FILE* solver;                                       // xfoil process (open only during a simulation)
+    std::string name;                                   // Airfoil name (first line of the coordinates file)
+    bool airfoilLoaded;                                 // Whether an airfoil has been loaded
+    PolarResult polar;                                  // Simulation results
+    std::vector<std::pair<double, double>> front;       // Pareto front of (CL, L/D)
+    OptimalPoint optimal;                               // Optimal configuration
+};
+
+#endif // AIRFOIL_SESSION_H
@@ -0,0 +1,56 @@
+#ifndef BATCH_SIMULATION_H
+#define BATCH_SIMULATION_H
+
+#include "store_sim_results.h"
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+
+// Single xfoil simulation to be run as part of a batch
+struct SimulationJob {
+    std::string airfoilFile;        // Path of the airfoil coordinates file (as passed to xfoil)
+    std::string polarFile;          // Name of the polar file written by xfoil in the Output folder
+    double reynolds = 0.0;          // Reynolds number
+    double firstAlpha = 0.0;        // Starting angle of attack
+    double lastAlpha = 0.0;         // Ending angle of attack
+    double alphaStep = 0.0;         // Increment of alpha at each iteration
+    int nodes = 0;                  // Number of panel nodes
+    int iterations = 0;             // Maximum number of iterations for each alpha
+
+    std::vector<Point> geometry;    // Coordinates generated in memory, used instead of the airfoil file if not empty
+    std::string airfoilName;        // Name of the generated airfoil
+    std::string nacaCode;           // Digits of a NACA 4 or 5-digit airfoil generated by xfoil itself (no file is written)
+    bool captureSurface = false;    // Whether the surface distributions of every converged alpha are stored (see surface_data.h)
+    int warmupPoints = 0;           // Alpha values run before the first one only to start from a converged solution (discarded)
+};
+
+// Function called with the index and the results of each job as soon as it is completed.
+// It is called from the worker threads, so it must be safe to call from different threads at the same time
+typedef std::function<void(size_t, const PolarResult&)> BatchCallback;
+
+// Function to create a job simulating the given airfoil with the current configuration
+SimulationJob makeSimulationJob(const std::string& airfoilFile, const std::string& polarFile);
+
+// Function to get the airfoil coordinates of a job, in the format of a coordinates file
+// (the airfoil file, or the generated geometry written as saveToFile() does)
+std::string readJobGeometry(const SimulationJob& job);
+
+// Function to run a single job in a new xfoil process and read its results (an empty polar means the simulation failed).
+// Captured surface distributions are appended to the data file, or returned as encoded records if a buffer is given
+PolarResult runSimulationJob(const SimulationJob& job, std::string* surfaceRecords = nullptr);
+
+// Function to run a batch of simulations on parallel local xfoil processes only (no remote workers, no journal)
+std::vector<PolarResult> runLocalSimulationBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                                const BatchCallback& onJobCompleted = nullptr);
+
+// Function to run a batch of simulations on parallel xfoil processes.
+// Results are returned in the same order as the jobs (an empty polar means the simulation failed), and each one
+// is also passed to the callback (if any) as soon as it is available, e.g. to show the progress of long batches.
+// If a coordinator port is set, the batch is handed to remote workers instead.
+// If a run journal is open, alpha values already recorded are not simulated again, and new results are recorded
+std::vector<PolarResult> runSimulationBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                           const BatchCallback& onJobCompleted = nullptr);
+
+#endif // BATCH_SIMULATION_H
@@ -2,10 +2,14 @@
 #define BUILD_PARETO_FRONT_H
 
 #include <vector>
+#include <utility>
 
 // Function to build the Pareto front from the given data
 void buildParetoFront(const std::vector<double>& alpha, const std::vector<double>& cL, const std::vector<double>& cD);
 
+// Function to compute the Pareto front of the given data, without using global variables
+std::vector<std::pair<double, double>> computeParetoFront(const std::vector<double>& cL, const std::vector<double>& cD, const std::vector<double>& efficiency);
+
 // Global vector that stores the Pareto front
 extern std::vector<std::pair<double, double>> paretoFront;
 
@@ -1,8 +1,12 @@
 #ifndef CONFIG_SETTINGS_H
 #define CONFIG_SETTINGS_H
 
+#include <vector>
+#include <string>
+
 void showConfiguration();       // Function to show current values of simulation parameters
 bool modifyConfiguration();     // Function to modify current values of simulation parameters
+double getPositiveInput(const std::string& prompt);    // Function to ask the user for a positive value
 
 // Simulation parameters
 extern const int panelNodes;            // Number of nodes along the airfoil's surface in xfoil
@@ -12,6 +16,49 @@ extern const double alphaEnd;           // Ending angle of attack
 extern const double alphaIncrement;     // Increment of alpha at each iteration
 extern double reynoldsNumber;           // Reynolds number
 
+// Parallel execution parameters
+extern const unsigned int simulationWorkers;    // Number of xfoil processes run at the same time by batch simulations
+
+// Distributed execution parameters
+extern int coordinatorPort;                 // Port on which batches are handed to remote workers (0 to run them locally). Set from the command line
+extern std::string coordinatorAddress;      // Address on which the coordinator accepts workers (loopback unless set from the command line)
+extern const int alphaChunkPoints;          // Number of alpha values in each task sent to a remote worker
+extern const int alphaChunkOverlap;         // Alpha values run (and discarded) before each task, so that it starts from a converged solution
+extern const int workerTimeout;             // Time after which a worker not returning its task is considered dead  [s]
+extern const int workerWaitTimeout;         // Time waited for a worker when none is connected, before running the batch locally  [s]
+
+// Panel convergence study parameters
+extern const std::vector<int> panelCandidates;      // Panel node counts tried by the convergence study (increasing)
+extern const int probeAlphas;                       // Number of angles of attack (evenly spread in the alpha range) used as probes
+extern const double panelTolerance;                 // Maximum relative difference of CL and CD from the finest discretization
+
+// Manufacturing robustness analysis parameters
+extern const int robustnessSamples;         // Number of perturbed geometries simulated for each airfoil
+extern const double surfaceTolerance;       // RMS amplitude of the random surface deviations  [m]
+extern const int perturbationModes;         // Number of smooth modes used to build each surface deviation
+extern const unsigned int robustnessSeed;   // Seed of the random generator (same seed gives the same geometries)
+
+// Wing analysis parameters
+extern const int liftingLineStations;       // Number of spanwise stations used by the lifting-line method
+extern const int wingPolarCount;            // Number of Reynolds numbers (from tip to root chord) at which section polars are computed
+extern const double tipTwist;               // Twist of the tip section relative to the root (negative for washout)  [deg]
+
+// Sensitivity analysis parameters
+extern const double solverNoise;            // Resolution of the coefficients written by xfoil, used to choose the finite-difference steps
+extern const std::vector<double> shapeModePeaks;    // Chordwise position of the peak of each bump used as shape mode (upper and lower surface)
+
+// Parametric family parameters
+extern const int familySurfacePoints;       // Number of points generated on each surface of a family member
+extern const int cstOrder;                  // Order of the Bernstein polynomials of CST airfoils (order + 1 coefficients per surface)
+extern const size_t familyBatchSize;        // Number of family members generated and simulated at a time
+
+// Surface data parameters
+extern bool captureSurface;                 // Whether Cp, Cf, displacement thickness and transition are captured at every alpha. Set from the command line
+
+// Run journal parameters
+extern const size_t journalSyncRecords;     // Number of journal records after which the journal is synced to disk
+extern const int journalSyncInterval;       // Time after which new journal records are synced to disk  [s]
+
 // Variables used to calculate Reynolds number. Can be changed by the user during execution
 extern double chord;                  // Airfoil chord (trailing edge - leading edge)     [m]
 extern double cruiseSpeed;            // Drone cruise speed                               [m/s]
@@ -13,4 +13,13 @@ void sendCommandToXfoil(const std::string& command);
 // Function to close XFOIL process
 void closeXfoil();
 
+// Function to open a new XFOIL process, independent from the global one (returns nullptr on failure)
+FILE* openXfoilProcess();
+
+// Function to close the given XFOIL process
+void closeXfoilProcess(FILE* process);
+
+// Global file pointer for the XFOIL process used by the interactive simulation
+extern FILE* xfoil;
+
 #endif // CONTROL_XFOIL_H
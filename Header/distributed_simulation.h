@@ -0,0 +1,19 @@
+#ifndef DISTRIBUTED_SIMULATION_H
+#define DISTRIBUTED_SIMULATION_H
+
+#include "batch_simulation.h"
+
+#include <string>
+#include <vector>
+
+// Function to run a batch of simulations on the remote workers connected to the given port.
+// Jobs are split in (airfoil, Reynolds number, alpha range) tasks, and the partial polars are merged back
+// (results are returned in the same order as the jobs, an empty polar means the simulation failed)
+// The callback (if any) is called with the merged polar of each job as soon as all its tasks are completed.
+// If no worker is connected for the configured time, the tasks left are run on local xfoil processes
+std::vector<PolarResult> runDistributedBatch(const std::vector<SimulationJob>& jobs, int port, const BatchCallback& onJobCompleted = nullptr);
+
+// Function to run a worker: connect to the coordinator and simulate the tasks it sends (never returns)
+void runSimulationWorker(const std::string& host, int port);
+
+#endif // DISTRIBUTED_SIMULATION_H
@@ -1,6 +1,17 @@
 #ifndef FIND_OPTIMAL_CONFIG_H
 #define FIND_OPTIMAL_CONFIG_H
 
+#include <vector>
+#include <cstddef>
+
+// Values of an optimal configuration
+struct OptimalPoint {
+    double alpha;
+    double cL;
+    double cD;
+    double efficiency;
+};
+
 // Global variables used to store optimal configuration values
 extern double alphaOptimal;
 extern double cLOptimal;
@@ -10,4 +21,8 @@ extern double efficiencyOptimal;
 // Function to find optimal configuration within the Pareto front
 void findOptimalConfig();
 
+// Function to find the index of the optimal point of a polar, applying the same criterion
+// used by findOptimalConfig() (returns cL.size() if there are no valid points)
+size_t findOptimalIndex(const std::vector<double>& cL, const std::vector<double>& cD, const std::vector<double>& efficiency);
+
 #endif // FIND_OPTIMAL_CONFIG_H
\ No newline at end of file
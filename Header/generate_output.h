@@ -1,9 +1,15 @@
 #ifndef GENERATE_OUTPUT_H
 #define GENERATE_OUTPUT_H
 
+#include "find_optimal_config.h"
+
 #include <string>
 
 // Function to write the optimization recap file
 void writeRecapFile(const std::string& airfoilFile);
 
+// Function to write a recap file with the given values, without using global variables (returns false on failure)
+bool writeRecap(const std::string& recapFilename, const std::string& airfoilName, double chordValue, double speedValue,
+                double viscosityValue, double reynolds, const OptimalPoint& optimal);
+
 #endif
\ No newline at end of file
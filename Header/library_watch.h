@@ -0,0 +1,42 @@
+#ifndef LIBRARY_WATCH_H
+#define LIBRARY_WATCH_H
+
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Simulation result of a single (Reynolds number, alpha) point of an airfoil
+struct LibraryPoint {
+    double reynolds;
+    double alpha;
+    double cL;
+    double cD;
+    bool converged;
+    int iterations;         // Iteration limit used (a point that did not converge is retried with a higher limit)
+};
+
+// Airfoil of the library, with the hash of its normalized geometry and all the points simulated for it
+struct LibraryAirfoil {
+    std::string name;                       // Airfoil name (first line of the coordinates file)
+    uint64_t geometryHash;                  // Hash of the normalized geometry and panel nodes the points refer to
+    std::vector<LibraryPoint> points;       // Simulated points
+    std::vector<LibraryPoint> front;        // Non-dominated (CL, L/D) points at the current Reynolds number
+};
+
+// Function to compute the hash of an airfoil geometry (points as produced by processAirfoilPoints()) and of the
+// panel nodes used to simulate it
+uint64_t hashGeometry(const std::vector<Point>& points, int nodes);
+
+// Function to update the given airfoil files (names inside the Input folder), simulating only the missing points
+void updateLibrary(const std::vector<std::string>& filenames);
+
+// Function to run the watch mode: keep the results of every airfoil in the Input folder up to date
+void runWatchMode();
+
+// Global map storing the library, by file name inside the Input folder
+extern std::map<std::string, LibraryAirfoil> library;
+
+#endif // LIBRARY_WATCH_H
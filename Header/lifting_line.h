@@ -0,0 +1,55 @@
+#ifndef LIFTING_LINE_H
+#define LIFTING_LINE_H
+
+#include "store_sim_results.h"
+
+#include <vector>
+#include <string>
+
+// Section polars of an airfoil computed at different Reynolds numbers (sorted by increasing Reynolds number)
+struct SectionPolars {
+    std::vector<double> reynolds;       // Reynolds number of each polar
+    std::vector<PolarResult> polars;    // Polars (alpha values sorted in increasing order)
+};
+
+// Wing planform, symmetric about the root. Chord and twist are given at stations evenly spaced from root to tip
+struct Planform {
+    double span;                    // Wing span (tip to tip)               [m]
+    std::vector<double> chord;      // Chord at each station (root first)   [m]
+    std::vector<double> twist;      // Twist at each station (root first)   [deg]
+};
+
+// Single wing analysis: a planform with the section polars of its airfoil at a given root angle of attack
+struct WingCase {
+    const Planform* planform;
+    const SectionPolars* sections;
+    double alpha;                   // Angle of attack of the root section  [deg]
+};
+
+// Results of the lifting-line analysis of a wing
+struct WingResult {
+    double alpha;           // Angle of attack of the root section  [deg]
+    double cL;              // Wing lift coefficient
+    double cDi;             // Induced drag coefficient
+    double cDp;             // Profile drag coefficient (from the section polars)
+    double efficiency;      // Wing lift-to-drag ratio (CL / (CDi + CDp))
+    double stallMargin;     // Smallest difference between maximum and actual section CL along the span
+    bool converged;         // Whether the nonlinear iterations converged
+};
+
+// Function to create a trapezoidal planform (linear chord and twist from root to tip)
+Planform makeTrapezoidalPlanform(double span, double rootChord, double taperRatio, double tipTwist);
+
+// Function to analyze a wing with the nonlinear lifting-line method
+WingResult solveLiftingLine(const WingCase& wing);
+
+// Function to analyze a batch of wings on parallel threads (results in the same order as the cases)
+std::vector<WingResult> solveLiftingLineBatch(const std::vector<WingCase>& wings, unsigned int workers);
+
+// Function to find the angle of attack giving the best wing lift-to-drag ratio within the configured alpha range
+WingResult findBestWingConfig(const Planform& planform, const SectionPolars& sections);
+
+// Function to compute the section polars needed by a planform and run the interactive wing analysis
+void runWingAnalysis(const std::string& airfoilFile);
+
+#endif // LIFTING_LINE_H
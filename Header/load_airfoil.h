@@ -2,6 +2,7 @@
 #define LOAD_AIRFOIL_H
 
 #include <string>
+#include <cstdio>
 
 // Function to open xfoil process using a pipe
 void openXfoil();
@@ -15,4 +16,10 @@ void closeXfoil();
 // Function to load airfoil into xfoil and configure panel nodes
 void loadAirfoilToXfoil(const std::string& formattedFileName);
 
+// Function to load airfoil into the given xfoil process with the given number of panel nodes
+void loadAirfoilToXfoil(FILE* process, const std::string& formattedFileName, int nodes);
+
+// Function to generate a NACA 4 or 5-digit airfoil (e.g. "2412") in the given xfoil process, without any coordinates file
+void loadNacaToXfoil(FILE* process, const std::string& nacaCode, int nodes);
+
 #endif // LOAD_AIRFOIL_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef PANEL_CONVERGENCE_H
+#define PANEL_CONVERGENCE_H
+
+#include <string>
+#include <map>
+
+// Function to run the panel convergence study of an airfoil, recording and returning the chosen panel node count
+int runPanelConvergenceStudy(const std::string& airfoilFile);
+
+// Function to get the key identifying the panel node count of an airfoil: hash of the contents of its file and
+// Reynolds number, so that an edited file, the same file at a different Reynolds number or a renamed copy are handled correctly
+std::string panelNodesKey(const std::string& airfoilFile, double reynolds);
+
+// Function to check whether a panel node count has already been chosen for an airfoil (at the current Reynolds number)
+bool hasPanelNodes(const std::string& airfoilFile);
+
+// Function to get the panel node count to use for an airfoil (default value if no study has been run)
+int getPanelNodes(const std::string& airfoilFile);
+
+// Function to read the panel node count stored in a file for an airfoil and Reynolds number, without changing the
+// loaded counts, so that it can be called from different threads (default value if no study has been run)
+int readPanelNodes(const std::string& filename, const std::string& airfoilFile, double reynolds, int defaultNodes);
+
+// Function to save the panel node counts chosen so far to a file
+void savePanelNodes(const std::string& filename);
+
+// Function to load the panel node counts chosen in previous runs from a file
+void loadPanelNodes(const std::string& filename);
+
+// Global map storing the panel node count chosen for each airfoil (by key, see panelNodesKey())
+extern std::map<std::string, int> panelNodesByAirfoil;
+
+#endif // PANEL_CONVERGENCE_H
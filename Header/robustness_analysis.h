@@ -0,0 +1,28 @@
+#ifndef ROBUSTNESS_ANALYSIS_H
+#define ROBUSTNESS_ANALYSIS_H
+
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+#include <random>
+
+// Statistics of a quantity over all the perturbed geometries
+struct SampleStatistics {
+    double mean;
+    double stdDev;
+    double min;
+    double max;
+};
+
+// Function to generate a perturbed airfoil, displacing the surface along its normal by a smooth random deviation
+// (amplitude is the RMS deviation, in the same units as the coordinates)
+std::vector<Point> perturbAirfoil(const std::vector<Point>& points, double amplitude, int modes, std::mt19937& generator);
+
+// Function to compute mean, standard deviation, minimum and maximum of the given values
+SampleStatistics computeStatistics(const std::vector<double>& values);
+
+// Function to run the manufacturing robustness analysis of an airfoil and write its recap file
+void runRobustnessAnalysis(const std::string& airfoilFile);
+
+#endif // ROBUSTNESS_ANALYSIS_H
@@ -0,0 +1,38 @@
+#ifndef RUN_JOURNAL_H
+#define RUN_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Result of a simulated (airfoil, Reynolds number, alpha) unit
+struct JournalUnit {
+    double alpha;           // Angle of attack
+    bool converged;         // Whether xfoil converged at this alpha
+    double cL;              // CL value (0 if not converged)
+    double cD;              // CD value (0 if not converged)
+};
+
+// Function to open the journal of a campaign (e.g. a family sweep), replaying the units recorded by previous runs
+// of the same campaign. Batches run while the journal is open skip the recorded units (see batch_simulation.cpp)
+bool openRunJournal(const std::string& campaign);
+
+// Function to close the journal. A completed campaign removes its journal, so that running it again starts from scratch
+void closeRunJournal(bool completed);
+
+// Function to remove the units recorded so far, once their results have been saved elsewhere (the journal stays open)
+void clearRunJournal();
+
+// Function to check whether a journal is open
+bool runJournalOpen();
+
+// Function to compute the key of the simulations sharing the given inputs (geometry, discretization, Reynolds number)
+uint64_t journalKey(const std::string& inputs);
+
+// Function to find a recorded unit (false if it was not simulated yet)
+bool findJournalUnit(uint64_t key, double alpha, JournalUnit& unit);
+
+// Function to record the given units with a single append. Records are synced to disk in batches
+void recordJournalUnits(uint64_t key, const std::vector<JournalUnit>& units);
+
+#endif // RUN_JOURNAL_H
@@ -0,0 +1,40 @@
+#ifndef SENSITIVITY_ANALYSIS_H
+#define SENSITIVITY_ANALYSIS_H
+
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+
+// Derivative estimated by finite differences, with an estimate of its error
+struct Sensitivity {
+    double value;
+    double error;
+    bool valid;         // False if a perturbed simulation did not converge at this alpha
+};
+
+// Derivatives of CL, CD and L/D with respect to a single variable, at each alpha of the simulation
+struct SensitivityRow {
+    std::string variable;                   // Variable name
+    double step;                            // Finite-difference step used
+    std::vector<Sensitivity> dCL;
+    std::vector<Sensitivity> dCD;
+    std::vector<Sensitivity> dEfficiency;
+};
+
+// Jacobian of the polar with respect to alpha, Reynolds number and shape modes
+struct SensitivityResult {
+    std::vector<double> alpha;              // Alpha values at which the derivatives are evaluated
+    std::vector<SensitivityRow> rows;       // One row for each variable
+};
+
+// Function to apply a shape mode (a bump on the upper or lower surface) to an airfoil
+std::vector<Point> applyShapeMode(const std::vector<Point>& points, size_t mode, double amplitude);
+
+// Function to compute the Jacobian of the polar of an airfoil, running all the perturbed simulations in parallel
+SensitivityResult computeSensitivities(const std::string& airfoilFile);
+
+// Function to run the sensitivity analysis of an airfoil and write its recap file
+void runSensitivityAnalysis(const std::string& airfoilFile);
+
+#endif // SENSITIVITY_ANALYSIS_H
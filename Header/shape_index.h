@@ -0,0 +1,68 @@
+#ifndef SHAPE_INDEX_H
+#define SHAPE_INDEX_H
+
+#include "format_airfoil.h"
+
+#include <string>
+#include <vector>
+
+// Number of x-stations used to resample each surface (upper and lower) of the airfoil
+extern const int shapeStations;
+
+// Maximum RMS distance (in chord units) between two signatures for them to be considered the same airfoil
+extern const double duplicateShapeTolerance;
+
+// Polar computed by xfoil for a given Reynolds number
+struct StoredPolar {
+    double reynolds;                // Reynolds number used for the simulation
+    std::vector<double> alpha;      // Angle of attack values
+    std::vector<double> cL;         // CL values
+    std::vector<double> cD;         // CD values
+    std::string settings;           // Other solver inputs (panel nodes, iteration limit, alpha range), see solverSettingsKey()
+};
+
+// Airfoil shape stored in the index, together with all the polars already solved for it
+struct ShapeEntry {
+    std::string name;                   // Airfoil name (first line of the coordinates file)
+    std::vector<double> signature;      // Normalized shape signature (upper surface y, then lower surface y)
+    std::vector<StoredPolar> polars;    // Polars already computed for this shape
+};
+
+// Result of a nearest-neighbour query
+struct ShapeMatch {
+    size_t entry;       // Index of the matching entry in the shape index
+    double distance;    // RMS distance between the signatures (in chord units)
+};
+
+// Function to compute the normalized shape signature of an airfoil (points as produced by processAirfoilPoints())
+std::vector<double> computeShapeSignature(const std::vector<Point>& points);
+
+// Function to compute the RMS distance between two shape signatures
+double shapeDistance(const std::vector<double>& a, const std::vector<double>& b);
+
+// Function to add a solved polar to the index (shapes within the duplicate tolerance share the same entry)
+size_t addShapeToIndex(const std::string& name, const std::vector<double>& signature, const StoredPolar& polar);
+
+// Function to find the k shapes closest to the given signature, sorted by increasing distance
+std::vector<ShapeMatch> findNearestShapes(const std::vector<double>& signature, size_t k);
+
+// Function to describe the solver inputs of a polar other than shape and Reynolds number, so that a stored polar
+// is reused only if it would be computed in exactly the same way
+std::string solverSettingsKey(int nodes, int iterations, double firstAlpha, double lastAlpha, double alphaStep);
+
+// Function to find an already-solved polar for (almost) the same shape at the same Reynolds number and solver settings
+const StoredPolar* findDuplicatePolar(const std::vector<double>& signature, double reynolds, const std::string& settings);
+
+// Function to estimate a polar by inverse-distance weighting of the closest solved neighbours
+bool estimatePolarFromNeighbours(const std::vector<double>& signature, double reynolds, size_t k, StoredPolar& estimate);
+
+// Function to append a solved polar to the shape index file (the file is never rewritten, so saving is O(1) per polar)
+void appendShapeIndex(const std::string& filename, const std::string& name, const std::vector<double>& signature, const StoredPolar& polar);
+
+// Function to load the shape index from a file (missing file means empty index)
+void loadShapeIndex(const std::string& filename);
+
+// Global vector that stores all the indexed shapes
+extern std::vector<ShapeEntry> shapeIndex;
+
+#endif // SHAPE_INDEX_H
@@ -1,10 +1,17 @@
 #ifndef SIMULATE_AIRFOIL_H
 #define SIMULATE_AIRFOIL_H
 #include <string>
+#include <cstdio>
 
 // Function to run airfoil simulation in xfoil
 void runSimulation();
 
+// Function to run an airfoil simulation in the given xfoil process, writing the polar to the given path.
+// If a surface files prefix is given, the surface distributions of every alpha are also written (see surface_data.h).
+// The sweep can start some warm-up alpha values before the first one, so that the first one starts from a converged solution
+void runSimulation(FILE* process, double reynolds, int iterations, double firstAlpha, double lastAlpha, double alphaStep,
+                   const std::string& polarPath, const std::string& surfacePrefix = "", int warmupPoints = 0);
+
 // Variable to store the name of the file where simulation results will be saved
 extern std::string simDataFile;
 
@@ -2,10 +2,28 @@
 #define STORE_SIM_RESULTS_H
 
 #include <vector>
+#include <string>
 
-// Function to read simulation results from a file, ignoring non-relevant lines
-void storeSimulationResults();
+// Polar read from an xfoil output file (converged alpha values only)
+struct PolarResult {
+    std::vector<double> alpha;          // Angle of attack values
+    std::vector<double> cL;             // CL values
+    std::vector<double> cD;             // CD values
+    std::vector<double> efficiency;     // CL/CD values
+};
 
+// Function to read simulation results from a file, ignoring non-relevant lines (returns the number of values stored,
+// 0 if the file could not be read or no alpha value converged)
+size_t storeSimulationResults();
+
+// Function to read a polar file written by xfoil (returns false if the file cannot be opened)
+bool readPolarFile(const std::string& filename, PolarResult& polar);
+
+// Function to store results of a polar that has already been computed (without reading the xfoil output file)
+// (returns the number of values stored, at the start of the arrays)
+size_t storePolarResults(const std::vector<double>& alphaValues, const std::vector<double>& cLValues, const std::vector<double>& cDValues);
+
+extern size_t numAlphaSteps;                    // Number of steps in the alpha range
 extern std::vector<double> alpha;               // Array to store alpha values
 extern std::vector<double> cL;                  // Array to store CL values
 extern std::vector<double> cD;                  // Array to store CD values
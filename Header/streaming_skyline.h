@@ -0,0 +1,41 @@
+#ifndef STREAMING_SKYLINE_H
+#define STREAMING_SKYLINE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <mutex>
+
+// Simulated point offered to the skyline, with the information needed to identify it
+struct SkylinePoint {
+    std::string source;     // Airfoil the point belongs to
+    double reynolds;        // Reynolds number
+    double alpha;           // Angle of attack
+    double cL;              // CL value
+    double cD;              // CD value
+    double efficiency;      // CL/CD value
+};
+
+// Online Pareto front of (CL, L/D): points are offered one at a time, and only the non-dominated ones are kept,
+// so memory is proportional to the size of the front and not to the number of points offered.
+// Points can be offered and the front read from different threads at the same time
+class StreamingSkyline {
+public:
+    StreamingSkyline() : offered(0) {}
+
+    bool insert(const SkylinePoint& point);             // Offer a point (returns true if it is on the current front)
+    std::vector<SkylinePoint> front() const;            // Current front, by decreasing CL (increasing L/D)
+    bool optimum(SkylinePoint& point) const;            // Current optimum (false if no point has been accepted yet)
+    size_t size() const;                                // Number of points on the current front
+    size_t pointsOffered() const;                       // Number of points offered so far
+    void clear();                                       // Remove all the points
+    bool writeFront(const std::string& filename, const std::string& title) const;  // Write the current front to a file
+
+private:
+    mutable std::mutex lock;
+    std::map<double, SkylinePoint, std::greater<double>> points;   // Front by decreasing CL (L/D increases along the map)
+    size_t offered;
+};
+
+#endif // STREAMING_SKYLINE_H
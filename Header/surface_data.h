@@ -0,0 +1,77 @@
+#ifndef SURFACE_DATA_H
+#define SURFACE_DATA_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <cstdint>
+
+// Distributions along the airfoil surface for a single (airfoil, Reynolds number, alpha) solution.
+// Points follow the xfoil panel order: from the upper trailing edge, around the leading edge, to the lower trailing edge
+struct SurfaceDistribution {
+    std::string airfoil;            // Airfoil name (first line of the coordinates file)
+    double reynolds;                // Reynolds number
+    double alpha;                   // Angle of attack
+    double xtrTop;                  // Transition location on the upper surface  [x/c]
+    double xtrBottom;               // Transition location on the lower surface  [x/c]
+    std::vector<double> x;          // Chordwise position of each point
+    std::vector<double> y;          // Vertical position of each point
+    std::vector<double> cp;         // Pressure coefficient
+    std::vector<double> cf;         // Skin friction coefficient
+    std::vector<double> dstar;      // Displacement thickness  [fraction of chord]
+};
+
+// File storing the surface distributions of every simulation run with capture enabled
+extern const std::string surfaceDataFile;
+
+// Function to get the prefix of the surface files written by xfoil next to the given polar file
+std::string surfaceFilesPrefix(const std::string& polarPath);
+
+// Function to get the path of a surface file ("cp" or "bl") of the alpha with the given index in the sweep
+std::string surfaceFilePath(const std::string& prefix, size_t index, const std::string& type);
+
+// Function to get the path of the polar accumulated while the surface files are written (converged solutions only)
+std::string surfacePolarPath(const std::string& prefix);
+
+// Function to get the number of alpha values of a sweep (same values run by the xfoil 'aseq' command)
+size_t countSurfaceAlphas(double firstAlpha, double lastAlpha, double alphaStep);
+
+// Function to read the surface files written by xfoil for a sweep, keeping the alpha values converged both in the
+// given polar file and when solved again for the surface files. The files are removed, and the distributions are
+// returned encoded as records of the data file
+std::string collectSurfaceRecords(const std::string& airfoil, double reynolds, const std::string& prefix,
+                                  double firstAlpha, double lastAlpha, double alphaStep, const std::string& polarPath);
+
+// Function to append encoded records to the data file (safe to call from different threads at the same time)
+bool appendSurfaceRecords(const std::string& records);
+
+// Function to encode a distribution as a record of the data file
+std::string encodeSurfaceRecord(const SurfaceDistribution& distribution);
+
+// Function to print the distribution stored for the given airfoil, Reynolds number and alpha (false if not found)
+bool showSurfaceDistribution(const std::string& airfoil, double reynolds, double alpha);
+
+// Random-access reader of the data file. The file is memory-mapped and indexed once when opened, so that each
+// lookup only decodes the record requested. Records appended after opening are not seen until the file is opened again
+class SurfaceDataReader {
+public:
+    SurfaceDataReader();
+    ~SurfaceDataReader();
+    SurfaceDataReader(const SurfaceDataReader&) = delete;
+    SurfaceDataReader& operator=(const SurfaceDataReader&) = delete;
+
+    bool open(const std::string& filename);     // Map and index a data file (false if it cannot be read)
+    void close();                               // Unmap the file
+    bool find(const std::string& airfoil, double reynolds, double alpha, SurfaceDistribution& distribution) const;
+    size_t size() const;                        // Number of (airfoil, Reynolds number, alpha) solutions stored
+
+private:
+    const char* data;                           // Contents of the file
+    size_t length;                              // Size of the file
+    std::string copy;                           // Contents of the file, if it could not be mapped
+    void* mapping;                              // Handle of the mapping (platform dependent)
+    std::map<std::tuple<std::string, int64_t, int32_t>, size_t> index;     // Offset of each record (last one written wins)
+};
+
+#endif // SURFACE_DATA_H
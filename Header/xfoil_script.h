@@ -0,0 +1,33 @@
+#ifndef XFOIL_SCRIPT_H
+#define XFOIL_SCRIPT_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+// XFOIL command script compiled from a template: the fixed text is split around the placeholders,
+// so that each run only has to insert the values (no parsing and no string concatenation of commands)
+struct XfoilScript {
+    std::vector<std::string> text;      // Fixed text before each placeholder (one more element than slots, for the text after the last one)
+    std::vector<size_t> slots;          // Index of the value replacing each placeholder
+};
+
+// Function to compile a script template. Placeholders are written as "{name}", and the values given to
+// renderXfoilScript() must follow the order of the names list
+XfoilScript compileXfoilScript(const std::string& source, const std::vector<std::string>& names);
+
+// Function to write the commands of a compiled script with the given values into a buffer (which is overwritten,
+// so that the same buffer can be reused by every run)
+void renderXfoilScript(const XfoilScript& script, const std::vector<std::string>& values, std::string& commands);
+
+// Function to append the commands of a compiled script with the given values to a buffer, e.g. to repeat
+// a block of commands for every alpha value
+void appendXfoilScript(const XfoilScript& script, const std::vector<std::string>& values, std::string& commands);
+
+// Function to send a block of commands to the given XFOIL process with a single buffered write
+void sendScriptToXfoil(FILE* process, const std::string& commands);
+
+// Function to format a value to be inserted in a script (same format used by std::to_string)
+std::string formatScriptValue(double value);
+
+#endif // XFOIL_SCRIPT_H
@@ -0,0 +1,425 @@
+/*
+    This file implements a generator of parametric airfoil families, used to explore whole families
+    (e.g. every NACA 4-digit airfoil with 2-4% camber and 9-15% thickness) without writing coordinates files.
+
+    A family is defined by a range of values for each parameter, and its members are all the combinations
+    of these values. Members are identified by their index, and generated only when needed, directly in the
+    format produced by processAirfoilPoints() (upper surface from trailing to leading edge, then lower surface),
+    so that the family is never stored as a whole. Available families:
+      - NACA 4-digit and 5-digit (standard and reflexed mean lines), with closed trailing edge
+      - NACA 6-series approximation: a=1.0 mean line with a modified 4-digit thickness distribution, whose
+        maximum thickness is moved back as in the 6-series (the exact thickness comes from conformal mapping)
+      - CST (class/shape transformation): every combination of the given values of the Bernstein coefficients
+
+    The sweep generates a batch of members at a time and simulates them in parallel (or on remote workers).
+    NACA 4-digit and standard 5-digit members (mean lines 210 to 250) are generated by xfoil itself with its
+    'naca' command, so no file is written for them (xfoil uses its own definition, with the original open trailing
+    edge). The other members (reflexed 5-digit, 6-series and CST) can only be loaded from a coordinates file,
+    written in the Output folder and removed as soon as xfoil has read it. The optimal configuration of each member is appended to
+    'family_results.txt' as soon as its simulation is completed, and all the points are offered to a streaming
+    skyline, whose front across the whole family is kept up to date in 'family_pareto.txt'.
+    Simulated points are recorded in a run journal, so that an interrupted sweep can be resumed.
+*/
+
+#include "../Header/airfoil_family.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/find_optimal_config.h"
+#include "../Header/streaming_skyline.h"
+#include "../Header/run_journal.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <cmath>
+
+const std::string familyResultsFile = "Output/family_results.txt";     // Optimal configuration of every member
+const std::string familyParetoFile = "Output/family_pareto.txt";       // Pareto front across the whole family
+
+const double pi = std::acos(-1.0);
+
+// Number of values in the range
+size_t ParameterRange::count() const {
+    if (step <= 0.0 || last < first) {
+        return 1;
+    }
+    return static_cast<size_t>(std::floor((last - first) / step + 1.0e-9)) + 1;
+}
+
+// i-th value of the range
+double ParameterRange::value(size_t i) const {
+    return first + i * (step > 0.0 ? step : 0.0);
+}
+
+// Read a family from command line arguments: the family type followed by one range ("first:last:step",
+// or a single value) for each parameter
+bool parseFamilySpec(const std::vector<std::string>& arguments, FamilySpec& spec) {
+    if (arguments.empty()) {
+        return false;
+    }
+
+    size_t numParameters = 0;
+    if (arguments[0] == "naca4")       { spec.type = FamilyNaca4; numParameters = 3; }
+    else if (arguments[0] == "naca5")  { spec.type = FamilyNaca5; numParameters = 4; }
+    else if (arguments[0] == "naca6")  { spec.type = FamilyNaca6; numParameters = 3; }
+    else if (arguments[0] == "cst")    { spec.type = FamilyCst;   numParameters = 2; }
+    else {
+        return false;
+    }
+    if (arguments.size() != numParameters + 1) {
+        return false;
+    }
+
+    spec.parameters.clear();
+    for (size_t i = 1; i < arguments.size(); ++i) {
+        std::string text = arguments[i];
+        std::replace(text.begin(), text.end(), ':', ' ');
+        std::istringstream ss(text);
+
+        ParameterRange range = {0.0, 0.0, 0.0};
+        if (!(ss >> range.first)) {
+            return false;
+        }
+        if (!(ss >> range.last >> range.step)) {
+            range.last = range.first;       // Single value
+            range.step = 0.0;
+        }
+        spec.parameters.push_back(range);
+    }
+    return true;
+}
+
+// Number of members of a family. CST families use the same range for all the coefficients of a surface
+size_t familySize(const FamilySpec& spec) {
+    size_t size = 1;
+    for (const auto& range : spec.parameters) {
+        size_t count = range.count();
+        for (int c = 0; c < (spec.type == FamilyCst ? cstOrder + 1 : 1); ++c) {
+            size *= count;
+        }
+    }
+    return size;
+}
+
+// Helper function to build the points of an airfoil from its mean line and thickness distribution,
+// with cosine spacing (points are denser at leading and trailing edge, as in xfoil)
+std::vector<Point> buildFromMeanLine(const std::function<double(double)>& camber, const std::function<double(double)>& slope,
+                                     const std::function<double(double)>& thickness) {
+    std::vector<Point> upper, lower;
+    for (int i = familySurfacePoints; i >= 1; --i) {
+        double x = 0.5 * (1.0 - std::cos(pi * i / familySurfacePoints));
+        double theta = std::atan(slope(x));
+        double yc = camber(x);
+        double yt = thickness(x);
+        upper.push_back({x - yt * std::sin(theta), yc + yt * std::cos(theta)});
+        lower.push_back({x + yt * std::sin(theta), yc - yt * std::cos(theta)});
+    }
+
+    // Upper surface from the trailing edge, leading edge, then lower surface towards the trailing edge
+    std::vector<Point> points(upper);
+    points.push_back({0.0, 0.0});
+    points.insert(points.end(), lower.rbegin(), lower.rend());
+    return points;
+}
+
+// Helper function to get the NACA 4-digit thickness distribution (closed trailing edge)
+double naca4Thickness(double x, double t) {
+    return 5.0 * t * (0.2969 * std::sqrt(x) - 0.1260 * x - 0.3516 * x * x + 0.2843 * x * x * x - 0.1036 * x * x * x * x);
+}
+
+// Helper function to generate a NACA 4-digit airfoil
+bool generateNaca4(int camberDigit, int positionDigit, int thicknessDigits, std::string& name, std::vector<Point>& points) {
+    double m = camberDigit / 100.0;
+    double p = positionDigit / 10.0;
+    double t = thicknessDigits / 100.0;
+    if (camberDigit < 0 || camberDigit > 9 || positionDigit < 0 || positionDigit > 9 || t <= 0.0 || (m > 0.0 && p <= 0.0)) {
+        return false;
+    }
+
+    std::ostringstream designation;
+    designation << "NACA " << camberDigit << positionDigit << std::setw(2) << std::setfill('0') << thicknessDigits;
+    name = designation.str();
+
+    auto camber = [m, p](double x) {
+        if (m == 0.0) return 0.0;
+        return x < p ? m / (p * p) * (2.0 * p * x - x * x) : m / ((1.0 - p) * (1.0 - p)) * (1.0 - 2.0 * p + 2.0 * p * x - x * x);
+    };
+    auto slope = [m, p](double x) {
+        if (m == 0.0) return 0.0;
+        return x < p ? 2.0 * m / (p * p) * (p - x) : 2.0 * m / ((1.0 - p) * (1.0 - p)) * (p - x);
+    };
+    points = buildFromMeanLine(camber, slope, [t](double x) { return naca4Thickness(x, t); });
+    return true;
+}
+
+// Helper function to generate a NACA 5-digit airfoil (standard or reflexed mean line)
+bool generateNaca5(int liftDigit, int positionDigit, int reflexDigit, int thicknessDigits, std::string& name, std::vector<Point>& points) {
+    // Mean line constants for each camber position (x/c = 0.05 to 0.25), for design CL = 0.3
+    const double standardM[5] = {0.0580, 0.1260, 0.2025, 0.2900, 0.3910};
+    const double standardK1[5] = {361.4, 51.64, 15.957, 6.643, 3.230};
+    const double reflexM[5] = {0.0, 0.1300, 0.2170, 0.3180, 0.4410};
+    const double reflexK1[5] = {0.0, 51.99, 15.793, 6.520, 3.191};
+    const double reflexRatio[5] = {0.0, 0.000764, 0.00677, 0.0303, 0.1355};    // k2/k1
+
+    double t = thicknessDigits / 100.0;
+    bool reflexed = (reflexDigit == 1);
+    if (liftDigit < 0 || liftDigit > 9 || positionDigit < 1 || positionDigit > 5 || (reflexDigit != 0 && reflexDigit != 1) ||
+        t <= 0.0 || (reflexed && positionDigit == 1)) {
+        return false;
+    }
+
+    std::ostringstream designation;
+    designation << "NACA " << liftDigit << positionDigit << reflexDigit << std::setw(2) << std::setfill('0') << thicknessDigits;
+    name = designation.str();
+
+    int row = positionDigit - 1;
+    double m = reflexed ? reflexM[row] : standardM[row];
+    double k1 = reflexed ? reflexK1[row] : standardK1[row];
+    double r = reflexed ? reflexRatio[row] : 0.0;
+    double scale = 0.15 * liftDigit / 0.3;      // Mean line ordinates are proportional to the design CL
+
+    auto camber = [=](double x) {
+        if (!reflexed) {
+            return scale * (x < m ? k1 / 6.0 * (x * x * x - 3.0 * m * x * x + m * m * (3.0 - m) * x) : k1 * m * m * m / 6.0 * (1.0 - x));
+        }
+        double cubic = (x < m ? 1.0 : r) * (x - m) * (x - m) * (x - m);
+        return scale * k1 / 6.0 * (cubic - r * std::pow(1.0 - m, 3) * x - m * m * m * x + m * m * m);
+    };
+    auto slope = [=](double x) {
+        if (!reflexed) {
+            return scale * (x < m ? k1 / 6.0 * (3.0 * x * x - 6.0 * m * x + m * m * (3.0 - m)) : -k1 * m * m * m / 6.0);
+        }
+        double quadratic = (x < m ? 1.0 : r) * 3.0 * (x - m) * (x - m);
+        return scale * k1 / 6.0 * (quadratic - r * std::pow(1.0 - m, 3) - m * m * m);
+    };
+    points = buildFromMeanLine(camber, slope, [t](double x) { return naca4Thickness(x, t); });
+    return true;
+}
+
+// Helper function to generate a NACA 6-series approximation.
+// Thickness is a modified 4-digit distribution with the maximum at x/c = 0.2 + 0.05 * series (0.35 for the 63-series),
+// made of a forward part a0*sqrt(x) + a1*x + a2*x^2 + a3*x^3 and an aft part d1*(1-x) + d2*(1-x)^2 + d3*(1-x)^3,
+// joined at the maximum thickness with continuous slope and curvature. The mean line is the uniform load (a=1.0) one
+bool generateNaca6(int series, int liftDigit, int thicknessDigits, std::string& name, std::vector<Point>& points) {
+    double t = thicknessDigits / 100.0;
+    if (series < 1 || series > 7 || liftDigit < 0 || liftDigit > 9 || t <= 0.0) {
+        return false;
+    }
+
+    std::ostringstream designation;
+    designation << "NACA 6" << series << "-" << liftDigit << std::setw(2) << std::setfill('0') << thicknessDigits << " (approx.)";
+    name = designation.str();
+
+    // Aft part (for 20% thickness, as in the original definition): closed trailing edge, maximum at x = M
+    double M = 0.2 + 0.05 * series;
+    double u = 1.0 - M;
+    double d1 = M <= 0.3 ? 0.200 + (M - 0.2) * 0.34 : M <= 0.4 ? 0.234 + (M - 0.3) * 0.81
+              : M <= 0.5 ? 0.315 + (M - 0.4) * 1.50 : 0.465 + (M - 0.5) * 2.35;     // Tabulated trailing edge slope
+    double d3 = -(2.0 * (0.1 - d1 * u) + d1 * u) / (u * u * u);
+    double d2 = (-d1 - 3.0 * d3 * u * u) / (2.0 * u);
+
+    // Forward part: leading edge radius index 5 (sharper than the 4-digit one), then match value, slope and curvature
+    double a0 = 0.296904 * 5.0 / 6.0;
+    double rhs[3] = {0.1 - a0 * std::sqrt(M), -a0 / (2.0 * std::sqrt(M)), 2.0 * d2 + 6.0 * d3 * u + a0 / (4.0 * std::pow(M, 1.5))};
+    // Equations: a1*M + a2*M^2 + a3*M^3 = rhs0, a1 + 2*a2*M + 3*a3*M^2 = rhs1, 2*a2 + 6*a3*M = rhs2
+    double a3 = (rhs[0] - rhs[1] * M + rhs[2] * M * M / 2.0) / (M * M * M);
+    double a2 = (rhs[2] - 6.0 * a3 * M) / 2.0;
+    double a1 = rhs[1] - 2.0 * a2 * M - 3.0 * a3 * M * M;
+
+    auto thickness = [=](double x) {
+        double y = x < M ? a0 * std::sqrt(x) + a1 * x + a2 * x * x + a3 * x * x * x
+                         : d1 * (1.0 - x) + d2 * (1.0 - x) * (1.0 - x) + d3 * (1.0 - x) * (1.0 - x) * (1.0 - x);
+        return t / 0.2 * y;
+    };
+
+    double designLift = liftDigit / 10.0;
+    auto camber = [designLift](double x) {
+        if (x <= 0.0 || x >= 1.0) return 0.0;
+        return -designLift / (4.0 * pi) * ((1.0 - x) * std::log(1.0 - x) + x * std::log(x));
+    };
+    auto slope = [designLift](double x) {
+        x = std::min(std::max(x, 1.0e-6), 1.0 - 1.0e-6);       // The slope is infinite at leading and trailing edge
+        return designLift / (4.0 * pi) * std::log((1.0 - x) / x);
+    };
+    points = buildFromMeanLine(camber, slope, thickness);
+    return true;
+}
+
+// Helper function to generate a CST airfoil: y = sqrt(x) * (1 - x) * sum(A_i * K_i * x^i * (1 - x)^(n - i)) on each surface
+bool generateCst(const std::vector<double>& upperCoefficients, const std::vector<double>& lowerCoefficients,
+                 std::string& name, std::vector<Point>& points) {
+    int n = static_cast<int>(upperCoefficients.size()) - 1;
+
+    auto surface = [n](const std::vector<double>& coefficients, double x) {
+        double shape = 0.0;
+        double binomial = 1.0;
+        for (int i = 0; i <= n; ++i) {
+            shape += coefficients[i] * binomial * std::pow(x, i) * std::pow(1.0 - x, n - i);
+            binomial = binomial * (n - i) / (i + 1);
+        }
+        return std::sqrt(x) * (1.0 - x) * shape;
+    };
+
+    std::vector<Point> upper, lower;
+    for (int i = familySurfacePoints; i >= 1; --i) {
+        double x = 0.5 * (1.0 - std::cos(pi * i / familySurfacePoints));
+        upper.push_back({x, surface(upperCoefficients, x)});
+        lower.push_back({x, surface(lowerCoefficients, x)});
+        if (i < familySurfacePoints && upper.back().y <= lower.back().y) {
+            return false;       // Surfaces crossing each other
+        }
+    }
+
+    std::ostringstream designation;
+    designation << "CST u[";
+    for (size_t i = 0; i < upperCoefficients.size(); ++i) {
+        designation << (i > 0 ? " " : "") << upperCoefficients[i];
+    }
+    designation << "] l[";
+    for (size_t i = 0; i < lowerCoefficients.size(); ++i) {
+        designation << (i > 0 ? " " : "") << lowerCoefficients[i];
+    }
+    designation << "]";
+    name = designation.str();
+
+    points = upper;
+    points.push_back({0.0, 0.0});
+    points.insert(points.end(), lower.rbegin(), lower.rend());
+    return true;
+}
+
+// Generate the index-th member of a family. The index is split in the indices of the single parameter values
+// (the last parameter changes fastest), so that each member is generated without enumerating the previous ones
+bool generateFamilyMember(const FamilySpec& spec, size_t index, std::string& name, std::vector<Point>& points) {
+    if (index >= familySize(spec)) {
+        return false;
+    }
+
+    // Value of each parameter (for CST families, one value for each coefficient of each surface)
+    std::vector<double> values;
+    std::vector<const ParameterRange*> ranges;
+    for (const auto& range : spec.parameters) {
+        for (int c = 0; c < (spec.type == FamilyCst ? cstOrder + 1 : 1); ++c) {
+            ranges.push_back(&range);
+        }
+    }
+    values.resize(ranges.size());
+    for (size_t i = ranges.size(); i-- > 0; ) {
+        values[i] = ranges[i]->value(index % ranges[i]->count());
+        index /= ranges[i]->count();
+    }
+
+    auto digit = [&values](size_t i) { return static_cast<int>(std::lround(values[i])); };
+    switch (spec.type) {
+        case FamilyNaca4:   return generateNaca4(digit(0), digit(1), digit(2), name, points);
+        case FamilyNaca5:   return generateNaca5(digit(0), digit(1), digit(2), digit(3), name, points);
+        case FamilyNaca6:   return generateNaca6(digit(0), digit(1), digit(2), name, points);
+        case FamilyCst:     return generateCst(std::vector<double>(values.begin(), values.begin() + cstOrder + 1),
+                                               std::vector<double>(values.begin() + cstOrder + 1, values.end()), name, points);
+    }
+    return false;
+}
+
+// Helper function to get the digits of a member that xfoil can generate with its 'naca' command (empty if it cannot):
+// 4-digit airfoils, and 5-digit ones with a standard mean line of design CL 0.3 (first three digits 210 to 250)
+std::string builtinNacaCode(const FamilySpec& spec, const std::string& name) {
+    std::string digits = name.substr(name.find(' ') + 1);
+    if (spec.type == FamilyNaca4 && digits.size() == 4) {
+        return digits;
+    }
+    if (spec.type == FamilyNaca5 && digits.size() == 5 && digits[0] == '2' && digits[2] == '0') {
+        return digits;
+    }
+    return "";
+}
+
+// Simulate every member of a family, a batch at a time
+void runFamilySweep(const FamilySpec& spec) {
+    size_t size = familySize(spec);
+
+    std::ofstream resultsFile(familyResultsFile);
+    if (!resultsFile) {
+        std::cerr << "ERROR: Could not open 'family_results.txt'" << std::endl;
+        return;
+    }
+    resultsFile << "\n--- FAMILY RESULTS ---\n\n";
+    resultsFile << "Reynolds Number: " << reynoldsNumber << "\n\n";
+    resultsFile << std::left << std::setw(36) << "Airfoil" << std::right << std::setw(10) << "Alpha"
+                << std::setw(10) << "CL" << std::setw(10) << "CD" << std::setw(10) << "L/D" << "\n";
+    resultsFile << std::fixed;
+
+    std::cout << "\nSimulating " << size << " family members on " << simulationWorkers << " parallel xfoil processes..." << std::endl;
+
+    // Record every simulated member in the journal of this family, so that an interrupted sweep started again
+    // with the same family only simulates the members (and alpha values) still missing
+    std::ostringstream campaign;
+    campaign << "family " << spec.type;
+    for (const auto& range : spec.parameters) {
+        campaign << " " << range.first << ":" << range.last << ":" << range.step;
+    }
+    openRunJournal(campaign.str());
+
+    StreamingSkyline skyline;
+    std::mutex progressLock;
+    size_t completed = 0, skipped = 0;
+
+    for (size_t start = 0; start < size; start += familyBatchSize) {
+        // Generate the members of this batch, skipping the ones with non-valid parameters
+        std::vector<SimulationJob> jobs;
+        for (size_t index = start; index < std::min(start + familyBatchSize, size); ++index) {
+            SimulationJob job = makeSimulationJob("", "family_" + std::to_string(jobs.size()) + "_polar.dat");
+            job.nodes = panelNodes;
+            job.captureSurface = captureSurface;
+            if (generateFamilyMember(spec, index, job.airfoilName, job.geometry)) {
+                job.nacaCode = builtinNacaCode(spec, job.airfoilName);
+                jobs.push_back(job);
+            }
+            else {
+                skipped++;
+            }
+        }
+
+        // Store the optimal configuration of each member and update the front as soon as its simulation is completed
+        auto storeMember = [&](size_t j, const PolarResult& polar) {
+            for (size_t i = 0; i < polar.alpha.size(); ++i) {
+                skyline.insert({jobs[j].airfoilName, jobs[j].reynolds, polar.alpha[i], polar.cL[i], polar.cD[i], 0.0});
+            }
+
+            std::lock_guard<std::mutex> guard(progressLock);
+            completed++;
+            size_t best = findOptimalIndex(polar.cL, polar.cD, polar.efficiency);
+            resultsFile << std::left << std::setw(36) << jobs[j].airfoilName << std::right;
+            if (best < polar.cL.size()) {
+                resultsFile << std::setprecision(3) << std::setw(10) << polar.alpha[best] << std::setw(10) << polar.cL[best]
+                            << std::setprecision(5) << std::setw(10) << polar.cD[best] << std::setprecision(3)
+                            << std::setw(10) << polar.efficiency[best] << "\n";
+            }
+            else {
+                resultsFile << std::setw(10) << "-" << "   Convergence failed for every alpha value\n";
+            }
+            skyline.writeFront(familyParetoFile, "FAMILY PARETO FRONT");
+        };
+
+        runSimulationBatch(jobs, simulationWorkers, storeMember);
+        resultsFile << std::flush;
+
+        SkylinePoint best;
+        std::cout << "  " << completed + skipped << "/" << size << " members, front: " << skyline.size() << " points";
+        if (skyline.optimum(best)) {
+            std::cout << ", best L/D " << std::fixed << std::setprecision(2) << best.efficiency << std::defaultfloat
+                      << " (" << best.source << ", alpha " << best.alpha << ")";
+        }
+        std::cout << std::endl;
+    }
+
+    skyline.writeFront(familyParetoFile, "FAMILY PARETO FRONT");
+    closeRunJournal(true);
+    if (skipped > 0) {
+        std::cout << skipped << " members skipped (non-valid parameters)." << std::endl;
+    }
+    std::cout << "Results stored in 'family_results.txt', Pareto front in 'family_pareto.txt'." << std::endl;
+}
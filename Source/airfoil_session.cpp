@@ -0,0 +1,180 @@
+/*
+    This file implements a self-contained airfoil analysis session, which can be used as a library
+    to embed the optimization workflow in other programs.
+
+    The interactive program stores its state in global variables (xfoil process, configuration, results,
+    Pareto front and optimal values) and terminates on errors. A session instead owns all its state:
+    a copy of the simulation parameters, its own xfoil process, the simulation results and a private
+    scratch directory for the files exchanged with xfoil (the formatted airfoil and the polar file).
+    Errors are returned to the caller as status values, and nothing is ever written to the original files.
+
+    Since sessions share no state, many of them can run at the same time on different threads,
+    each one driving its own xfoil process.
+*/
+
+#include "../Header/airfoil_session.h"
+#include "../Header/config_settings.h"
+#include "../Header/format_airfoil.h"
+#include "../Header/control_xfoil.h"
+#include "../Header/load_airfoil.h"
+#include "../Header/simulate_airfoil.h"
+#include "../Header/build_pareto_front.h"
+#include "../Header/generate_output.h"
+#include "../Header/panel_convergence.h"
+
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <cstdio>
+
+// Get a description of a session status, to be displayed to the user
+const char* describeSessionStatus(SessionStatus status) {
+    switch (status) {
+        case SessionOk:                 return "Success";
+        case SessionAirfoilNotFound:    return "Could not open the airfoil coordinates file";
+        case SessionInvalidAirfoil:     return "Not enough coordinates to load airfoil";
+        case SessionNoAirfoil:          return "No airfoil loaded";
+        case SessionScratchFailed:      return "Could not create the session scratch directory";
+        case SessionSolverFailed:       return "Failed to open xfoil";
+        case SessionResultsNotFound:    return "Could not open the simulation results file";
+        case SessionConvergenceFailed:  return "Convergence failed for every alpha value";
+        case SessionNoOptimum:          return "Could not find optimal value";
+        case SessionOutputFailed:       return "Could not write the recap file";
+    }
+    return "Unknown error";
+}
+
+// Reynolds number given by the session parameters (same formula used in config_settings.cpp)
+double SessionConfig::reynoldsNumber() const {
+    return (chord * cruiseSpeed) / kinematicViscosity;
+}
+
+// Create a session configuration with the current values of the simulation parameters
+SessionConfig makeSessionConfig() {
+    return {panelNodes, iterLimit, alphaStart, alphaEnd, alphaIncrement, chord, cruiseSpeed, kinematicViscosity};
+}
+
+// Create a session, with its own scratch directory inside the Output folder.
+// Directory creation is atomic, so trying increasing numbers gives a unique directory even across processes
+AirfoilSession::AirfoilSession(const SessionConfig& sessionConfig)
+    : config(sessionConfig), solver(nullptr), airfoilLoaded(false), optimal({0.0, 0.0, 0.0, 0.0}) {
+    std::error_code error;
+    std::filesystem::create_directories("Output", error);
+
+    for (int i = 0; i < 100000 && scratch.empty(); ++i) {
+        std::string candidate = "Output/session_" + std::to_string(i);
+        if (std::filesystem::create_directory(candidate, error)) {
+            scratch = candidate;
+        }
+        else if (error) {
+            break;      // Creation failed for a reason other than an existing directory
+        }
+    }
+}
+
+// Close the xfoil process (if still open) and remove the scratch directory
+AirfoilSession::~AirfoilSession() {
+    closeXfoilProcess(solver);
+    if (!scratch.empty()) {
+        std::error_code error;
+        std::filesystem::remove_all(scratch, error);
+    }
+}
+
+// Read the airfoil coordinates and save the formatted airfoil in the scratch directory
+SessionStatus AirfoilSession::loadAirfoil(const std::string& airfoilFile) {
+    airfoilLoaded = false;
+    if (scratch.empty()) {
+        return SessionScratchFailed;
+    }
+    if (!std::ifstream(airfoilFile).good()) {
+        return SessionAirfoilNotFound;
+    }
+
+    // Check the number of points before processing them (processAirfoilPoints() would terminate the program)
+    std::vector<Point> points = readCoordinatesFromFile(airfoilFile, name);
+    if (points.size() < 10) {
+        return SessionInvalidAirfoil;
+    }
+
+    saveToFile(scratch + "/airfoil.dat", name, processAirfoilPoints(points));
+    if (!std::ifstream(scratch + "/airfoil.dat").good()) {
+        return SessionScratchFailed;
+    }
+
+    airfoilLoaded = true;
+    return SessionOk;
+}
+
+// Run the simulation of the loaded airfoil in the session's own xfoil process
+SessionStatus AirfoilSession::runSimulation() {
+    polar = PolarResult();
+    front.clear();
+    optimal = {0.0, 0.0, 0.0, 0.0};
+
+    if (!airfoilLoaded) {
+        return SessionNoAirfoil;
+    }
+
+    std::string polarPath = scratch + "/polar.dat";
+    std::remove(polarPath.c_str());     // Remove old results, so that a failed run cannot return them
+
+    solver = openXfoilProcess();
+    if (solver == nullptr) {
+        return SessionSolverFailed;
+    }
+
+    // Use the panel nodes chosen by the convergence study for this airfoil, if the interactive program has run it.
+    // Counts are identified by the contents of the formatted file, so the session's copy finds the count of the original
+    int nodes = readPanelNodes("Output/panel_nodes.dat", scratch + "/airfoil.dat", config.reynoldsNumber(), config.panelNodes);
+
+    // Load the airfoil and run the simulation, then close xfoil waiting for the polar file to be written
+    loadAirfoilToXfoil(solver, scratch + "/airfoil.dat", nodes);
+    ::runSimulation(solver, config.reynoldsNumber(), config.iterLimit, config.alphaStart, config.alphaEnd,
+                    config.alphaIncrement, polarPath);
+    closeXfoilProcess(solver);
+    solver = nullptr;
+
+    if (!readPolarFile(polarPath, polar)) {
+        return SessionResultsNotFound;
+    }
+    if (polar.alpha.empty()) {
+        return SessionConvergenceFailed;
+    }
+
+    return SessionOk;
+}
+
+// Build the Pareto front of the results and take its first point as optimal configuration
+SessionStatus AirfoilSession::findOptimalConfig() {
+    front = computeParetoFront(polar.cL, polar.cD, polar.efficiency);
+
+    size_t best = findOptimalIndex(polar.cL, polar.cD, polar.efficiency);
+    if (best == polar.cL.size()) {
+        return SessionNoOptimum;
+    }
+
+    optimal = {polar.alpha[best], polar.cL[best], polar.cD[best], polar.efficiency[best]};
+    return SessionOk;
+}
+
+// Write the optimization recap file of the session
+SessionStatus AirfoilSession::writeRecapFile(const std::string& recapFilename) const {
+    if (!writeRecap(recapFilename, name, config.chord, config.cruiseSpeed, config.kinematicViscosity,
+                    config.reynoldsNumber(), optimal)) {
+        return SessionOutputFailed;
+    }
+    return SessionOk;
+}
+
+// Run the complete analysis of an airfoil, stopping at the first error
+SessionStatus AirfoilSession::analyze(const std::string& airfoilFile) {
+    SessionStatus status = loadAirfoil(airfoilFile);
+    if (status == SessionOk) {
+        status = runSimulation();
+    }
+    if (status == SessionOk) {
+        status = findOptimalConfig();
+    }
+    return status;
+}
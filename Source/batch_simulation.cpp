@@ -0,0 +1,313 @@
+/*
+    This file implements the parallel execution of batches of xfoil simulations. 
+    Each job describes a complete simulation (airfoil file, Reynolds number, alpha range and panel nodes),
+    and is run in its own xfoil process, so that different jobs do not share any state.
+
+    A fixed number of worker threads pick the jobs one at a time from a shared counter, so that the
+    load is balanced even when some simulations take longer than others (e.g. convergence problems).
+    Every job writes its own polar file, which is read back and removed once the simulation is completed
+    (together with the surface files, if the job captures them).
+    When the program runs as coordinator, batches are handed to remote workers (see distributed_simulation.cpp).
+
+    While a campaign journal is open (see run_journal.cpp), every job is first checked against the journal:
+    the alpha values already simulated are replayed, and only the missing ones are run, grouped in contiguous
+    ranges. A range starting after a recorded alpha also runs that alpha first (its result is discarded), so that
+    it starts from a converged solution as the complete sweep would. The result of each alpha is recorded as soon
+    as its range is completed, and the callback receives the whole polar of the job (replayed and new points)
+    once all its ranges are completed.
+*/
+
+#include "../Header/batch_simulation.h"
+#include "../Header/control_xfoil.h"
+#include "../Header/load_airfoil.h"
+#include "../Header/simulate_airfoil.h"
+#include "../Header/config_settings.h"
+#include "../Header/panel_convergence.h"
+#include "../Header/distributed_simulation.h"
+#include "../Header/surface_data.h"
+#include "../Header/run_journal.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+// Function to create a job simulating the given airfoil with the current configuration values
+// (and the panel nodes chosen by the convergence study, if already run for this airfoil)
+SimulationJob makeSimulationJob(const std::string& airfoilFile, const std::string& polarFile) {
+    SimulationJob job;
+    job.airfoilFile = airfoilFile;
+    job.polarFile = polarFile;
+    job.reynolds = reynoldsNumber;
+    job.firstAlpha = alphaStart;
+    job.lastAlpha = alphaEnd;
+    job.alphaStep = alphaIncrement;
+    job.nodes = getPanelNodes(airfoilFile);
+    job.iterations = iterLimit;
+    return job;
+}
+
+// Get the airfoil coordinates of a job
+std::string readJobGeometry(const SimulationJob& job) {
+    std::ostringstream text;
+    if (job.geometry.empty()) {
+        std::ifstream file(job.airfoilFile);
+        std::string line;
+        while (std::getline(file, line)) {
+            text << line << "\n";
+        }
+    }
+    else {
+        text << job.airfoilName << "\n";
+        for (const auto& point : job.geometry) {
+            text << point.x << " " << point.y << "\n";
+        }
+    }
+    return text.str();
+}
+
+// Run a single job in a new xfoil process and read its results
+PolarResult runSimulationJob(const SimulationJob& job, std::string* surfaceRecords) {
+    PolarResult polar;
+    std::string polarPath = "Output/" + job.polarFile;
+    std::remove(polarPath.c_str());         // Remove old results, so that a failed run cannot return them
+
+    // Xfoil can only load coordinates from a file: generated geometries are written next to the polar file,
+    // and removed as soon as xfoil is closed. NACA 4 and 5-digit airfoils are generated by xfoil itself instead
+    std::string airfoilPath = job.airfoilFile;
+    bool scratchGeometry = !job.geometry.empty() && job.nacaCode.empty();
+    if (scratchGeometry) {
+        airfoilPath = polarPath.substr(0, polarPath.rfind('.')) + "_geometry.dat";
+        saveToFile(airfoilPath, job.airfoilName, job.geometry);
+    }
+
+    FILE* process = openXfoilProcess();
+    if (process == nullptr) {
+        std::cerr << "\nWarning: Failed to open xfoil for '" << (job.geometry.empty() ? job.airfoilFile : job.airfoilName) << "'." << std::endl;
+        return polar;
+    }
+
+    // Load the airfoil and run the simulation, then close xfoil waiting for the polar file to be written
+    std::string surfacePrefix = job.captureSurface ? surfaceFilesPrefix(polarPath) : "";
+    if (job.nacaCode.empty()) {
+        loadAirfoilToXfoil(process, airfoilPath, job.nodes);
+    }
+    else {
+        loadNacaToXfoil(process, job.nacaCode, job.nodes);
+    }
+    runSimulation(process, job.reynolds, job.iterations, job.firstAlpha, job.lastAlpha, job.alphaStep, polarPath, surfacePrefix,
+                  job.warmupPoints);
+    closeXfoilProcess(process);
+
+    // Store the surface distributions under the name of the airfoil (first line of its coordinates file)
+    if (job.captureSurface) {
+        std::string airfoilName = job.airfoilName;
+        if (job.nacaCode.empty()) {
+            std::ifstream airfoilFile(airfoilPath);
+            std::getline(airfoilFile, airfoilName);
+        }
+        std::string records = collectSurfaceRecords(airfoilName, job.reynolds, surfacePrefix, job.firstAlpha,
+                                                    job.lastAlpha, job.alphaStep, polarPath);
+        if (surfaceRecords) {
+            *surfaceRecords = records;
+        }
+        else {
+            appendSurfaceRecords(records);
+        }
+    }
+
+    if (scratchGeometry) {
+        std::remove(airfoilPath.c_str());
+    }
+
+    readPolarFile(polarPath, polar);
+    std::remove(polarPath.c_str());         // Results are kept in memory only
+
+    // Discard the warm-up alpha values (the surface files of the sweep start from the first alpha, so they are not stored)
+    if (job.warmupPoints > 0) {
+        size_t kept = 0;
+        for (size_t i = 0; i < polar.alpha.size(); ++i) {
+            if ((polar.alpha[i] - job.firstAlpha) / job.alphaStep > -0.5) {
+                polar.alpha[kept] = polar.alpha[i];
+                polar.cL[kept] = polar.cL[i];
+                polar.cD[kept] = polar.cD[i];
+                polar.efficiency[kept] = polar.efficiency[i];
+                kept++;
+            }
+        }
+        polar.alpha.resize(kept);
+        polar.cL.resize(kept);
+        polar.cD.resize(kept);
+        polar.efficiency.resize(kept);
+    }
+
+    return polar;
+}
+
+// Run all the jobs using the given number of worker threads, each one driving its own xfoil process
+std::vector<PolarResult> runLocalSimulationBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                                const BatchCallback& onJobCompleted) {
+    std::vector<PolarResult> results(jobs.size());
+    std::atomic<size_t> nextJob(0);     // Index of the next job to be run
+
+    // Each worker runs jobs until none is left
+    auto worker = [&]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+            results[i] = runSimulationJob(jobs[i]);
+            if (onJobCompleted) {
+                onJobCompleted(i, results[i]);
+            }
+        }
+    };
+
+    // Start the workers (never more than the jobs to run) and wait for all of them to finish
+    workers = static_cast<unsigned int>(std::min<size_t>(std::max(workers, 1u), jobs.size()));
+    std::vector<std::thread> threads;
+    for (unsigned int w = 0; w < workers; ++w) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return results;
+}
+
+// Helper function to run all the jobs on the remote workers (if the program runs as coordinator) or locally
+std::vector<PolarResult> executeSimulationBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                                const BatchCallback& onJobCompleted) {
+    if (coordinatorPort > 0) {
+        return runDistributedBatch(jobs, coordinatorPort, onJobCompleted);     // Remote workers run the simulations
+    }
+    return runLocalSimulationBatch(jobs, workers, onJobCompleted);
+}
+
+// Helper function to get the number of alpha values of a job (same values run by the xfoil 'aseq' command)
+size_t countJobAlphas(const SimulationJob& job) {
+    long count = job.alphaStep != 0.0 ? std::lround((job.lastAlpha - job.firstAlpha) / job.alphaStep) + 1 : 1;
+    return count < 1 ? 1 : static_cast<size_t>(count);
+}
+
+// Helper function to add the points of a partial polar to a polar, keeping alpha order
+void mergePolar(PolarResult& polar, const PolarResult& part) {
+    for (size_t i = 0; i < part.alpha.size(); ++i) {
+        size_t position = std::upper_bound(polar.alpha.begin(), polar.alpha.end(), part.alpha[i]) - polar.alpha.begin();
+        polar.alpha.insert(polar.alpha.begin() + position, part.alpha[i]);
+        polar.cL.insert(polar.cL.begin() + position, part.cL[i]);
+        polar.cD.insert(polar.cD.begin() + position, part.cD[i]);
+        polar.efficiency.insert(polar.efficiency.begin() + position, part.efficiency[i]);
+    }
+}
+
+// Helper function to run a batch while a journal is open, simulating only the alpha values not recorded yet
+std::vector<PolarResult> runJournaledBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                           const BatchCallback& onJobCompleted) {
+    std::vector<PolarResult> results(jobs.size());
+    std::vector<uint64_t> keys(jobs.size());
+    std::vector<size_t> unfinished(jobs.size(), 0);     // Number of ranges still running for each job
+    std::vector<SimulationJob> ranges;                  // Missing alpha ranges, each one run as a job
+    std::vector<size_t> owners;                         // Job each range belongs to
+    size_t replayed = 0, total = 0;
+
+    // Step 1: Replay the recorded alpha values of every job, and group the missing ones in contiguous ranges.
+    // Jobs are identified by everything that changes their results, except the alpha values
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const SimulationJob& job = jobs[j];
+        std::ostringstream inputs;
+        inputs << readJobGeometry(job) << job.nodes << " " << job.iterations << " " << std::llround(job.reynolds);
+        keys[j] = journalKey(inputs.str());
+
+        size_t points = countJobAlphas(job);
+        size_t first = points;
+        for (size_t i = 0; i <= points; ++i) {
+            JournalUnit unit;
+            bool missing = i < points && !findJournalUnit(keys[j], job.firstAlpha + i * job.alphaStep, unit);
+            if (i < points && !missing) {
+                replayed++;
+                if (unit.converged) {
+                    PolarResult point = {{unit.alpha}, {unit.cL}, {unit.cD}, {unit.cL / unit.cD}};
+                    mergePolar(results[j], point);
+                }
+            }
+
+            if (missing && first == points) {
+                first = i;      // Start of a missing range
+            }
+            else if (!missing && first < points) {
+                SimulationJob range = job;
+                range.firstAlpha = job.firstAlpha + first * job.alphaStep;
+                range.lastAlpha = job.firstAlpha + (i - 1) * job.alphaStep;
+                range.warmupPoints = first > 0 ? 1 : job.warmupPoints;     // Start from the last recorded alpha
+                range.polarFile = "range_" + std::to_string(ranges.size()) + "_" + job.polarFile;
+                ranges.push_back(range);
+                owners.push_back(j);
+                unfinished[j]++;
+                first = points;
+            }
+        }
+        total += points;
+    }
+
+    if (replayed > 0) {
+        std::cout << "Journal: " << replayed << " of " << total << " alpha values already simulated, "
+                  << ranges.size() << " range(s) left to run." << std::endl;
+    }
+
+    // Step 2: Jobs completely replayed are completed at once
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        if (unfinished[j] == 0 && onJobCompleted) {
+            onJobCompleted(j, results[j]);
+        }
+    }
+
+    // Step 3: Run the missing ranges, recording every alpha value as soon as its range is completed.
+    // Alpha values missing from a polar are recorded as not converged only if xfoil ran (some point converged),
+    // so that ranges lost because xfoil could not be started are simulated again by the next run
+    std::mutex lock;
+    auto recordRange = [&](size_t r, const PolarResult& polar) {
+        const SimulationJob& range = ranges[r];
+        std::vector<JournalUnit> units;
+        for (size_t i = 0; i < countJobAlphas(range); ++i) {
+            JournalUnit unit = {range.firstAlpha + i * range.alphaStep, false, 0.0, 0.0};
+            for (size_t p = 0; p < polar.alpha.size(); ++p) {
+                if (std::fabs(polar.alpha[p] - unit.alpha) < 1.0e-3) {
+                    unit = {polar.alpha[p], true, polar.cL[p], polar.cD[p]};
+                }
+            }
+            if (unit.converged || !polar.alpha.empty()) {
+                units.push_back(unit);
+            }
+        }
+        recordJournalUnits(keys[owners[r]], units);
+
+        size_t j = owners[r];
+        bool jobCompleted;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            mergePolar(results[j], polar);
+            jobCompleted = (--unfinished[j] == 0);
+        }
+        if (jobCompleted && onJobCompleted) {
+            onJobCompleted(j, results[j]);      // The merged polar is not modified anymore
+        }
+    };
+
+    if (!ranges.empty()) {
+        executeSimulationBatch(ranges, workers, recordRange);
+    }
+    return results;
+}
+
+// Run all the jobs on parallel xfoil processes (or remote workers), skipping the alpha values recorded in the journal
+std::vector<PolarResult> runSimulationBatch(const std::vector<SimulationJob>& jobs, unsigned int workers,
+                                           const BatchCallback& onJobCompleted) {
+    if (runJournalOpen()) {
+        return runJournaledBatch(jobs, workers, onJobCompleted);
+    }
+    return executeSimulationBatch(jobs, workers, onJobCompleted);
+}
@@ -23,12 +23,17 @@
 // The Pareto front will store points that represent optimal trade-offs between lift (cL) and efficiency (cL/cD).
     std::vector<std::pair<double, double>> paretoFront;
 
-// Function to build the Pareto front from the given alpha, cL, and cD data.
-// The Pareto front contains the set of points where no other point has both a higher lift (cL) and better efficiency (cL/cD).
+// Function to build the Pareto front from the given alpha, cL, and cD data, storing it in the global vector.
 void buildParetoFront(const std::vector<double>& alpha, const std::vector<double>& cL, const std::vector<double>& cD) {
-    // Clear the paretoFront vector to avoid conflicts between consecutive simulations
-    paretoFront.clear();
-    
+    // Replace the previous Pareto front to avoid conflicts between consecutive simulations
+    paretoFront = computeParetoFront(cL, cD, efficiency);
+}
+
+// Function to compute the Pareto front from the given cL, cD and efficiency data.
+// The Pareto front contains the set of points where no other point has both a higher lift (cL) and better efficiency (cL/cD).
+std::vector<std::pair<double, double>> computeParetoFront(const std::vector<double>& cL, const std::vector<double>& cD, const std::vector<double>& efficiency) {
+    std::vector<std::pair<double, double>> front;
+
     // Start from the first point and check subsequent points to find Pareto optimal solutions
     size_t i = 0;
 
@@ -55,8 +60,10 @@ void buildParetoFront(const std::vector<double>& alpha, const std::vector<double
 
         // If the current point (i) is Pareto optimal, add it to the Pareto front
         if (isParetoOptimal) {
-            paretoFront.push_back(std::make_pair(cL[i], efficiency[i]));    // Store (cL, cL/cD) in Pareto front
+            front.push_back(std::make_pair(cL[i], efficiency[i]));    // Store (cL, cL/cD) in Pareto front
             i++;  // Move to the next point
         }
     }
-}
\ No newline at end of file
+
+    return front;
+}
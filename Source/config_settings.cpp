@@ -9,6 +9,8 @@
 #include <iostream>
 #include <limits>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
 
 // Number of nodes along the airfoil's surface in xfoil. Used in load_airfoil.cpp
 const int panelNodes = 160;             
@@ -19,6 +21,49 @@ const double alphaStart = 0.0;         // Starting angle of attack
 const double alphaEnd = 10.0;           // Ending angle of attack
 const double alphaIncrement = 0.5;      // Increment of alpha at each iteration
 
+// Number of xfoil processes run at the same time by batch simulations (one per available CPU core)
+const unsigned int simulationWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+// Distributed execution parameters. Used in distributed_simulation.cpp
+int coordinatorPort = 0;                    // Port on which batches are handed to remote workers (0 to run them locally)
+std::string coordinatorAddress = "127.0.0.1";   // Address on which the coordinator accepts workers (loopback by default)
+const int alphaChunkPoints = 5;             // Number of alpha values in each task sent to a remote worker
+const int alphaChunkOverlap = 2;            // Alpha values run (and discarded) before each task, so that it starts from a converged solution
+const int workerTimeout = 600;              // Time after which a worker not returning its task is considered dead  [s]
+const int workerWaitTimeout = 60;           // Time waited for a worker when none is connected, before running the batch locally  [s]
+
+// Panel convergence study parameters. Used in panel_convergence.cpp
+const std::vector<int> panelCandidates = {80, 100, 120, 140, 160, 200, 240};   // Panel node counts tried (increasing)
+const int probeAlphas = 3;                  // Number of angles of attack (evenly spread in the alpha range) used as probes
+const double panelTolerance = 0.01;         // Maximum relative difference of CL and CD from the finest discretization
+
+// Manufacturing robustness analysis parameters. Used in robustness_analysis.cpp
+const int robustnessSamples = 200;          // Number of perturbed geometries simulated for each airfoil
+const double surfaceTolerance = 1.0e-4;     // RMS amplitude of the random surface deviations (0.1 mm)  [m]
+const int perturbationModes = 8;            // Number of smooth modes used to build each surface deviation
+const unsigned int robustnessSeed = 1;      // Seed of the random generator (same seed gives the same geometries)
+
+// Wing analysis parameters. Used in lifting_line.cpp
+const int liftingLineStations = 24;     // Number of spanwise stations used by the lifting-line method
+const int wingPolarCount = 3;           // Number of Reynolds numbers (from tip to root chord) at which section polars are computed
+const double tipTwist = -2.0;           // Twist of the tip section relative to the root (negative for washout)  [deg]
+
+// Sensitivity analysis parameters. Used in sensitivity_analysis.cpp
+const double solverNoise = 1.0e-4;                          // Resolution of the coefficients written by xfoil
+const std::vector<double> shapeModePeaks = {0.25, 0.6};     // Chordwise position of the peak of each bump (upper and lower surface)
+
+// Parametric family parameters. Used in airfoil_family.cpp
+const int familySurfacePoints = 80;         // Number of points generated on each surface (cosine spacing)
+const int cstOrder = 2;                     // Order of the Bernstein polynomials of CST airfoils
+const size_t familyBatchSize = 64;          // Number of family members generated and simulated at a time
+
+// Surface data parameters. Used in simulate_airfoil.cpp and surface_data.cpp
+bool captureSurface = false;                // Whether Cp, Cf, displacement thickness and transition are captured at every alpha
+
+// Run journal parameters. Used in run_journal.cpp
+const size_t journalSyncRecords = 256;      // Number of journal records after which the journal is synced to disk
+const int journalSyncInterval = 5;          // Time after which new journal records are synced to disk  [s]
+
 // Variables used to calculate Reynolds number
 double chord = 0.2334;                    // Airfoil chord (trailing edge - leading edge)     [m]
 double cruiseSpeed = 15.5;                // Drone cruise speed                               [m/s]       
@@ -3,6 +3,12 @@
     It allows opening a process to run xfoil, sending commands to it, and closing the process. 
     Xfoil is executed via a command-line interface, and this code handles the communication with xfoil 
     using pipes (standard input/output redirection).
+
+    Commands are buffered instead of being flushed one line at a time, so that a whole session reaches xfoil
+    in a single write (see also xfoil_script.cpp).
+
+    Besides the global process used by the interactive simulation, independent processes can be opened
+    and controlled through their own handle, so that several simulations can run at the same time.
 */
 
 #include "../Header/control_xfoil.h"
@@ -18,7 +24,7 @@ FILE* xfoil = nullptr;  // Global file pointer for xfoil process
 // It uses the popen() function to start xfoil as a subprocess and redirects its output to avoid displaying it.
 void openXfoil() {
     // Attempt to open xfoil as a subprocess
-    xfoil = popen("xfoil.exe > nul 2>&1", "w");     // "w" indicates writing mode (sending commands to xfoil)
+    xfoil = openXfoilProcess();
 
     // Check if the XFOIL process opened successfully
     if (xfoil == nullptr) {
@@ -32,11 +38,10 @@ void openXfoil() {
 // The command is passed as a string and converted to C-style string (using .c_str()) before sending it.
 void sendCommandToXfoil(const std::string& command) {
     if (xfoil) {    // Check if xfoil is open
-        // Write the command to the xfoil process and append a newline character
+        // Write the command to the xfoil process and append a newline character.
+        // Commands are buffered and reach xfoil together when the process is closed:
+        // xfoil reads them in order, and results are read only after closing it
         fprintf(xfoil, "%s\n", command.c_str());
-
-        // Flush the output to ensure the command is sent immediately to xfoil
-        fflush(xfoil); 
     } 
     else {
         // If xfoil is not open, print an error message
@@ -48,9 +53,25 @@ void sendCommandToXfoil(const std::string& command) {
 // Function to close the xfoil process
 // This function closes the xfoil process by calling pclose(), which terminates the pipe connection.
 void closeXfoil() {
-    if (xfoil) {    // Check if xfoil is open
-        // Close the xfoil process and reset the file pointer
-        pclose(xfoil);
-        xfoil = nullptr;    // Set the file pointer to null after closing
+    closeXfoilProcess(xfoil);
+    xfoil = nullptr;    // Set the file pointer to null after closing
+}
+
+// Function to open a new xfoil process.
+// Each process has its own pipe, so different processes can be controlled at the same time from different threads.
+FILE* openXfoilProcess() {
+    FILE* process = popen("xfoil.exe > nul 2>&1", "w");    // "w" indicates writing mode (sending commands to xfoil)
+
+    // Buffer large enough for a whole session, so that its commands reach xfoil in a single write
+    if (process) {
+        setvbuf(process, nullptr, _IOFBF, 16384);
+    }
+    return process;
+}
+
+// Function to close the given xfoil process, waiting for it to terminate
+void closeXfoilProcess(FILE* process) {
+    if (process) {    // Check if xfoil is open
+        pclose(process);
     }
 }
\ No newline at end of file
@@ -0,0 +1,610 @@
+/*
+    This file implements the distributed execution of batches of xfoil simulations over TCP, so that
+    large batches (e.g. a whole library on a grid of Reynolds numbers) can use more than one machine.
+
+    The program started with '--coordinator <port>' works as usual, but hands every batch to the workers
+    connected to that port (on the loopback interface, unless another address is given with '--bind <address>':
+    workers are not authenticated, so the port should only be reachable from trusted machines).
+    Each job is split in tasks of a few alpha values (airfoil, Reynolds number, alpha range), which are given
+    one at a time to the first idle worker, so that faster workers get more tasks. Every task also runs the last
+    alpha values of the previous one, which are discarded: this way the sweep reaches the first alpha of the
+    task from a converged solution, as it does when the whole job runs in a single xfoil process.
+    When no task is left to start, idle workers steal the tasks still running on the others, starting a
+    second copy of them: the first result received is kept, so a slow worker cannot delay the whole batch.
+    Workers closing the connection (or not answering within the timeout) are considered dead, and their
+    tasks are given to the other workers. The partial polars of each job are merged in alpha order as soon as
+    all its tasks are completed. If no worker is connected for some time, the rest of the batch is run locally.
+
+    Workers are started with '--worker <host> <port>': each one opens a connection for every local CPU core,
+    and keeps reconnecting to the coordinator, so it can be started before it and survives between batches.
+    Tasks carry the airfoil coordinates, so workers do not need the Input folder of the coordinator.
+
+    When the job captures the surface distributions, the worker sends back their encoded records after the
+    polar, and the coordinator appends them to its own data file (see surface_data.cpp).
+
+    Protocol (text lines, with the size of every message limited, so that a wrong peer cannot exhaust the memory):
+      coordinator -> worker:  TASK <id> <reynolds> <first alpha> <last alpha> <alpha step> <warm-up points> <nodes> <iterations> <capture>
+                                   <NACA digits, or - if the airfoil is not generated by xfoil> <lines>
+                              followed by the lines of the airfoil coordinates file
+      worker -> coordinator:  RESULT <id> <points> <bytes>
+                              followed by one '<alpha> <CL> <CD>' line for each converged point,
+                              then by the given number of bytes of surface records (0 if not captured)
+*/
+
+#include "../Header/distributed_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/surface_data.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <csignal>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET SocketHandle;
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+typedef int SocketHandle;
+const SocketHandle INVALID_SOCKET = -1;
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0      // Not available on every system: SIGPIPE is ignored anyway (see initializeSockets())
+#endif
+
+const int maxTaskCopies = 2;                        // Maximum number of workers running the same task at the same time
+const size_t maxLineLength = 64 * 1024;             // Longest line accepted from a peer
+const size_t maxMessageLines = 1000000;             // Maximum number of coordinates lines or polar points of a message
+const size_t maxSurfaceBytes = 256 * 1024 * 1024;   // Maximum size of the surface records of a result
+
+// Task of a distributed batch: a range of alpha values of a job
+struct DistributedTask {
+    size_t job;             // Index of the job the task belongs to
+    double firstAlpha;      // Starting angle of attack
+    double lastAlpha;       // Ending angle of attack
+    int warmupPoints;       // Alpha values of the previous task run before the first one (discarded)
+    int running;            // Number of workers currently running the task
+    bool done;              // Whether a result has been received
+    PolarResult polar;      // Partial polar returned by the worker
+};
+
+// State of a distributed batch, shared by the threads serving the workers
+struct DistributedBatch {
+    std::vector<DistributedTask> tasks;
+    size_t remaining;                   // Number of tasks without a result
+    std::vector<size_t> unfinished;     // Number of tasks without a result for each job
+    std::vector<PolarResult> results;   // Merged polar of each job
+    int lostWorkers;                    // Number of workers that died during the batch
+    int activeWorkers;                  // Number of workers currently connected
+    std::mutex lock;
+    std::condition_variable changed;    // Notified when a task is completed or given back
+};
+
+// Connection to a peer, with the data received but not read yet
+struct Connection {
+    SocketHandle socket;
+    std::string buffer;
+};
+
+// Helper function to close a socket
+void closeSocket(SocketHandle socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+// Helper function to initialize the sockets library (only needed on Windows). Elsewhere, writing to a connection
+// closed by the peer raises SIGPIPE, which would terminate the program: it is ignored, so that send() returns an error
+bool initializeSockets() {
+#ifdef _WIN32
+    static bool initialized = false;
+    WSADATA data;
+    if (!initialized && WSAStartup(MAKEWORD(2, 2), &data) == 0) {
+        initialized = true;
+    }
+    return initialized;
+#else
+    std::signal(SIGPIPE, SIG_IGN);
+    return true;
+#endif
+}
+
+// Helper function to set the time after which a receive operation fails
+void setReceiveTimeout(SocketHandle socket, int seconds) {
+#ifdef _WIN32
+    DWORD timeout = seconds * 1000;
+#else
+    timeval timeout = {seconds, 0};
+#endif
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+}
+
+// Helper function to send a whole message (false if the peer is gone)
+bool sendMessage(SocketHandle socket, const std::string& message) {
+    size_t sent = 0;
+    while (sent < message.size()) {
+        int count = send(socket, message.data() + sent, static_cast<int>(message.size() - sent), MSG_NOSIGNAL);
+        if (count <= 0) {
+            return false;
+        }
+        sent += count;
+    }
+    return true;
+}
+
+// Helper function to receive a line (false if the peer is gone, the timeout expired or the line is too long)
+bool receiveLine(Connection& connection, std::string& line) {
+    size_t end;
+    while ((end = connection.buffer.find('\n')) == std::string::npos) {
+        if (connection.buffer.size() > maxLineLength) {
+            return false;
+        }
+        char data[4096];
+        int count = recv(connection.socket, data, sizeof(data), 0);
+        if (count <= 0) {
+            return false;
+        }
+        connection.buffer.append(data, count);
+    }
+
+    line = connection.buffer.substr(0, end);
+    connection.buffer.erase(0, end + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+// Helper function to receive the given number of bytes (false if the peer is gone or the timeout expired)
+bool receiveBytes(Connection& connection, size_t count, std::string& data) {
+    while (connection.buffer.size() < count) {
+        char chunk[4096];
+        int received = recv(connection.socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        connection.buffer.append(chunk, received);
+    }
+
+    data = connection.buffer.substr(0, count);
+    connection.buffer.erase(0, count);
+    return true;
+}
+
+// Helper function to open the socket on which the coordinator accepts workers, on the configured address.
+// It stays open between batches, so that workers connecting meanwhile are served by the next batch
+SocketHandle openListeningSocket(int port) {
+    static SocketHandle listener = INVALID_SOCKET;
+    static int listenerPort = 0;
+    if (listener != INVALID_SOCKET && listenerPort == port) {
+        return listener;
+    }
+    if (!initializeSockets()) {
+        return INVALID_SOCKET;
+    }
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) {
+        return INVALID_SOCKET;
+    }
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<unsigned short>(port));
+    if (inet_pton(AF_INET, coordinatorAddress.c_str(), &address.sin_addr) != 1 ||
+        bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        closeSocket(listener);
+        listener = INVALID_SOCKET;
+        return INVALID_SOCKET;
+    }
+
+    listenerPort = port;
+    return listener;
+}
+
+// Helper function to give a task to an idle worker: a task not started yet if any, otherwise a copy of
+// the task running on the fewest workers (stealing it from slow workers). Returns tasks.size() if none is available.
+// Must be called with the batch lock held
+size_t pickTask(DistributedBatch& batch) {
+    size_t best = batch.tasks.size();
+    for (size_t t = 0; t < batch.tasks.size(); ++t) {
+        const DistributedTask& task = batch.tasks[t];
+        if (!task.done && task.running < maxTaskCopies &&
+            (best == batch.tasks.size() || task.running < batch.tasks[best].running)) {
+            best = t;
+        }
+    }
+    if (best < batch.tasks.size()) {
+        batch.tasks[best].running++;
+    }
+    return best;
+}
+
+// Helper function to store the result of a task (only the first one received), merging the partial polars of its
+// job in alpha order when it is the last one. Returns whether the job is completed. Must be called with the batch lock held
+bool storeTaskResult(DistributedBatch& batch, size_t t, const PolarResult& polar) {
+    DistributedTask& task = batch.tasks[t];
+    task.done = true;
+    task.polar = polar;
+    batch.remaining--;
+    if (--batch.unfinished[task.job] > 0) {
+        return false;
+    }
+
+    PolarResult& merged = batch.results[task.job];
+    for (const auto& part : batch.tasks) {
+        if (part.job != task.job) {
+            continue;
+        }
+        for (size_t i = 0; i < part.polar.alpha.size(); ++i) {
+            size_t position = std::upper_bound(merged.alpha.begin(), merged.alpha.end(), part.polar.alpha[i]) - merged.alpha.begin();
+            merged.alpha.insert(merged.alpha.begin() + position, part.polar.alpha[i]);
+            merged.cL.insert(merged.cL.begin() + position, part.polar.cL[i]);
+            merged.cD.insert(merged.cD.begin() + position, part.polar.cD[i]);
+            merged.efficiency.insert(merged.efficiency.begin() + position, part.polar.efficiency[i]);
+        }
+    }
+    return true;
+}
+
+// Helper function to run the tasks without a result on local xfoil processes, when no worker is available
+void runRemainingTasksLocally(DistributedBatch& batch, const std::vector<SimulationJob>& jobs, const BatchCallback& onJobCompleted) {
+    std::vector<size_t> pending;
+    std::vector<SimulationJob> taskJobs;
+    {
+        std::lock_guard<std::mutex> guard(batch.lock);
+        for (size_t t = 0; t < batch.tasks.size(); ++t) {
+            const DistributedTask& task = batch.tasks[t];
+            if (!task.done) {
+                SimulationJob job = jobs[task.job];
+                job.firstAlpha = task.firstAlpha;
+                job.lastAlpha = task.lastAlpha;
+                job.warmupPoints = task.warmupPoints;
+                job.polarFile = "task_" + std::to_string(t) + "_" + job.polarFile;
+                taskJobs.push_back(job);
+                pending.push_back(t);
+            }
+        }
+    }
+
+    // The local batch never hands the tasks back to the coordinator (nor records them in the journal twice)
+    runLocalSimulationBatch(taskJobs, simulationWorkers, [&](size_t i, const PolarResult& polar) {
+        size_t j = batch.tasks[pending[i]].job;
+        bool jobCompleted;
+        {
+            std::lock_guard<std::mutex> guard(batch.lock);
+            jobCompleted = !batch.tasks[pending[i]].done && storeTaskResult(batch, pending[i], polar);
+        }
+        if (jobCompleted && onJobCompleted) {
+            onJobCompleted(j, batch.results[j]);
+        }
+    });
+}
+
+// Helper function to serve a worker: send it tasks until the batch is completed or the worker dies
+void serveWorker(DistributedBatch& batch, SocketHandle socket, const std::vector<SimulationJob>& jobs,
+                 const std::vector<std::string>& geometries, const BatchCallback& onJobCompleted) {
+    Connection connection = {socket, ""};
+    setReceiveTimeout(socket, workerTimeout);
+
+    while (true) {
+        // Wait for a task to run (or for the batch to be completed)
+        size_t t;
+        {
+            std::unique_lock<std::mutex> guard(batch.lock);
+            batch.changed.wait(guard, [&]() { return batch.remaining == 0 || (t = pickTask(batch)) < batch.tasks.size(); });
+            if (batch.remaining == 0) {
+                return;
+            }
+        }
+
+        // Send the task together with the airfoil coordinates
+        const DistributedTask& task = batch.tasks[t];
+        const SimulationJob& job = jobs[task.job];
+        std::ostringstream message;
+        message << std::setprecision(12) << "TASK " << t << " " << job.reynolds << " " << task.firstAlpha << " "
+                << task.lastAlpha << " " << job.alphaStep << " " << task.warmupPoints << " " << job.nodes << " " << job.iterations << " " << job.captureSurface << " "
+                << (job.nacaCode.empty() ? "-" : job.nacaCode) << " "
+                << std::count(geometries[task.job].begin(), geometries[task.job].end(), '\n') << "\n"
+                << geometries[task.job];
+
+        // Receive the partial polar
+        PolarResult polar;
+        std::string line, keyword, surfaceRecords;
+        size_t id = 0, points = 0, bytes = 0;
+        bool received = sendMessage(socket, message.str()) && receiveLine(connection, line);
+        if (received) {
+            std::istringstream header(line);
+            received = (header >> keyword >> id >> points >> bytes) && keyword == "RESULT" && id == t &&
+                       points <= maxMessageLines && bytes <= maxSurfaceBytes;
+        }
+        for (size_t p = 0; received && p < points; ++p) {
+            double a, l, d;
+            std::istringstream row;
+            received = receiveLine(connection, line);
+            row.str(line);
+            if (received && (row >> a >> l >> d)) {
+                polar.alpha.push_back(a);
+                polar.cL.push_back(l);
+                polar.cD.push_back(d);
+                polar.efficiency.push_back(l / d);
+            }
+        }
+        received = received && receiveBytes(connection, bytes, surfaceRecords);
+
+        // Store the result (only the first one received for each task), or give the task back if the worker died.
+        // When the last task of a job is completed, its partial polars are merged
+        size_t j = task.job;
+        bool jobCompleted = false, firstResult = false;
+        {
+            std::lock_guard<std::mutex> guard(batch.lock);
+            batch.tasks[t].running--;
+            if (received && !batch.tasks[t].done) {
+                firstResult = true;
+                jobCompleted = storeTaskResult(batch, t, polar);
+            }
+            if (!received) {
+                if (!batch.tasks[t].done) {
+                    batch.lostWorkers++;    // Workers shut down while running a stolen copy of a completed task lost nothing
+                }
+                batch.activeWorkers--;
+            }
+            batch.changed.notify_all();
+        }
+
+        if (firstResult && !surfaceRecords.empty()) {
+            appendSurfaceRecords(surfaceRecords);   // Stolen copies of the task do not store the same solutions twice
+        }
+        if (jobCompleted && onJobCompleted) {
+            onJobCompleted(j, batch.results[j]);    // The merged polar is not modified anymore
+        }
+        if (!received) {
+            return;
+        }
+    }
+}
+
+// Run a batch of simulations on the remote workers connected to the given port
+std::vector<PolarResult> runDistributedBatch(const std::vector<SimulationJob>& jobs, int port, const BatchCallback& onJobCompleted) {
+    if (jobs.empty()) {
+        return std::vector<PolarResult>();
+    }
+
+    SocketHandle listener = openListeningSocket(port);
+    if (listener == INVALID_SOCKET) {
+        std::cerr << "\nWarning: Could not listen on " << coordinatorAddress << ":" << port << ", running simulations locally." << std::endl;
+        coordinatorPort = 0;
+        return runLocalSimulationBatch(jobs, simulationWorkers, onJobCompleted);
+    }
+
+    // Step 1: Read the airfoil files (or the generated geometries) and split every job in tasks of a few alpha values,
+    // each one starting with the last alpha values of the previous task
+    DistributedBatch batch;
+    batch.unfinished.assign(jobs.size(), 0);
+    batch.results.resize(jobs.size());
+    std::vector<std::string> geometries(jobs.size());
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        geometries[j] = readJobGeometry(jobs[j]);
+
+        const SimulationJob& job = jobs[j];
+        long count = job.alphaStep != 0.0 ? std::lround((job.lastAlpha - job.firstAlpha) / job.alphaStep) + 1 : 1;
+        if (count < 1) {
+            count = 1;
+        }
+        for (long first = 0; first < count; first += alphaChunkPoints) {
+            long last = std::min(first + alphaChunkPoints, count) - 1;
+            double firstAlpha = count > 1 ? job.firstAlpha + first * job.alphaStep : job.firstAlpha;
+            double lastAlpha = count > 1 ? job.firstAlpha + last * job.alphaStep : job.lastAlpha;
+            int warmupPoints = first == 0 ? job.warmupPoints : static_cast<int>(std::min<long>(first, alphaChunkOverlap));
+            batch.tasks.push_back({j, firstAlpha, lastAlpha, warmupPoints, 0, false, PolarResult()});
+            batch.unfinished[j]++;
+        }
+    }
+    batch.remaining = batch.tasks.size();
+    batch.lostWorkers = 0;
+    batch.activeWorkers = 0;
+
+    std::cout << "\nDistributing " << batch.tasks.size() << " tasks to the workers connected to port " << port
+              << "..." << std::endl;
+
+    // Step 2: Accept workers until every task has a result, serving each one in its own thread.
+    // If no worker is connected for too long, the tasks left are run locally
+    std::vector<SocketHandle> workers;
+    std::vector<std::thread> threads;
+    auto idleSince = std::chrono::steady_clock::now();      // Time since which no worker is connected
+    bool runLocally = false;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> guard(batch.lock);
+            if (batch.remaining == 0) {
+                break;
+            }
+            if (batch.activeWorkers > 0) {
+                idleSince = std::chrono::steady_clock::now();
+            }
+            else if (std::chrono::steady_clock::now() - idleSince >= std::chrono::seconds(workerWaitTimeout)) {
+                runLocally = true;
+                break;
+            }
+        }
+
+        fd_set descriptors;
+        FD_ZERO(&descriptors);
+        FD_SET(listener, &descriptors);
+        timeval interval = {0, 200000};
+        if (select(static_cast<int>(listener) + 1, &descriptors, nullptr, nullptr, &interval) > 0) {
+            SocketHandle worker = accept(listener, nullptr, nullptr);
+            if (worker != INVALID_SOCKET) {
+                {
+                    std::lock_guard<std::mutex> guard(batch.lock);
+                    batch.activeWorkers++;
+                }
+                workers.push_back(worker);
+                threads.emplace_back(serveWorker, std::ref(batch), worker, std::cref(jobs), std::cref(geometries),
+                                     std::cref(onJobCompleted));
+            }
+        }
+    }
+
+    if (runLocally) {
+        std::cerr << "Warning: No worker connected for " << workerWaitTimeout << " s, running the remaining tasks locally." << std::endl;
+        runRemainingTasksLocally(batch, jobs, onJobCompleted);
+    }
+
+    // Step 3: Disconnect the workers still running stolen copies of completed tasks (they reconnect for the next batch)
+    for (SocketHandle worker : workers) {
+#ifdef _WIN32
+        shutdown(worker, SD_BOTH);
+#else
+        shutdown(worker, SHUT_RDWR);
+#endif
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (SocketHandle worker : workers) {
+        closeSocket(worker);
+    }
+
+    if (batch.lostWorkers > 0) {
+        std::cout << "Warning: " << batch.lostWorkers << " worker connections lost, their tasks were rescheduled." << std::endl;
+    }
+
+    return batch.results;
+}
+
+// Helper function to connect to the coordinator (returns INVALID_SOCKET if it is not reachable)
+SocketHandle connectToCoordinator(const std::string& host, int port) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+        return INVALID_SOCKET;
+    }
+
+    SocketHandle connection = INVALID_SOCKET;
+    for (addrinfo* address = addresses; address != nullptr && connection == INVALID_SOCKET; address = address->ai_next) {
+        connection = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (connection != INVALID_SOCKET && connect(connection, address->ai_addr, static_cast<int>(address->ai_addrlen)) != 0) {
+            closeSocket(connection);
+            connection = INVALID_SOCKET;
+        }
+    }
+
+    freeaddrinfo(addresses);
+    return connection;
+}
+
+// Helper function to run a worker connection: simulate the tasks received until the coordinator disconnects
+void runWorkerConnection(SocketHandle socket, const std::string& scratchName) {
+    Connection connection = {socket, ""};
+    std::string line;
+
+    while (receiveLine(connection, line)) {
+        std::istringstream header(line);
+        std::string keyword;
+        size_t id, lines;
+        SimulationJob job;
+        job.airfoilFile = "Output/" + scratchName + ".dat";
+        job.polarFile = scratchName + "_polar.dat";
+        if (!(header >> keyword >> id >> job.reynolds >> job.firstAlpha >> job.lastAlpha >> job.alphaStep >> job.warmupPoints
+                     >> job.nodes >> job.iterations >> job.captureSurface >> job.nacaCode >> lines) || keyword != "TASK" ||
+            lines > maxMessageLines || job.warmupPoints < 0 || job.warmupPoints > alphaChunkPoints) {
+            return;
+        }
+        if (job.nacaCode == "-") {
+            job.nacaCode.clear();
+        }
+
+        // Save the airfoil coordinates so that xfoil can load them (airfoils generated by xfoil only need their name)
+        std::ofstream geometry;
+        if (job.nacaCode.empty()) {
+            geometry.open(job.airfoilFile);
+        }
+        for (size_t i = 0; i < lines; ++i) {
+            if (!receiveLine(connection, line)) {
+                return;
+            }
+            if (i == 0) {
+                job.airfoilName = line;
+            }
+            geometry << line << "\n";
+        }
+        geometry.close();
+
+        // Run the simulation and send back the converged points, followed by the surface records (if captured)
+        std::string surfaceRecords;
+        PolarResult polar = runSimulationJob(job, &surfaceRecords);
+        std::remove(job.airfoilFile.c_str());
+
+        std::ostringstream message;
+        message << std::setprecision(12) << "RESULT " << id << " " << polar.alpha.size() << " " << surfaceRecords.size() << "\n";
+        for (size_t i = 0; i < polar.alpha.size(); ++i) {
+            message << polar.alpha[i] << " " << polar.cL[i] << " " << polar.cD[i] << "\n";
+        }
+        message << surfaceRecords;
+        if (!sendMessage(socket, message.str())) {
+            return;
+        }
+    }
+}
+
+// Run a worker: one connection for each local CPU core, each one reconnecting whenever the coordinator disconnects
+void runSimulationWorker(const std::string& host, int port) {
+    if (!initializeSockets()) {
+        std::cerr << "ERROR: Could not initialize the network." << std::endl;
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories("Output", error);
+
+    // Random name for the scratch files, so that workers sharing the same folder do not overwrite each other's files
+    std::string token = std::to_string(std::random_device()());
+
+    std::cout << "Worker running " << simulationWorkers << " xfoil processes for the coordinator at "
+              << host << ":" << port << " (Ctrl+C to stop)..." << std::endl;
+
+    std::vector<std::thread> threads;
+    for (unsigned int w = 0; w < simulationWorkers; ++w) {
+        threads.emplace_back([&, w]() {
+            std::string scratchName = "remote_" + token + "_" + std::to_string(w);
+            while (true) {
+                SocketHandle connection = connectToCoordinator(host, port);
+                if (connection == INVALID_SOCKET) {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));      // Coordinator not running yet
+                    continue;
+                }
+                runWorkerConnection(connection, scratchName);
+                closeSocket(connection);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
@@ -70,4 +70,35 @@ void findOptimalConfig() {
     // If no matching point is found, display an error message and exit
     std::cerr << "\nERROR: Could not find optimal value." << std::endl;
     exit(1);
-}
\ No newline at end of file
+}
+
+// Function to find the index of the optimal point of a polar without using the global arrays.
+// The optimal point is the first point of the Pareto front built by buildParetoFront(), that is the first
+// valid point (starting from the lowest alpha) for which no subsequent point has both a higher cL and efficiency
+size_t findOptimalIndex(const std::vector<double>& cL, const std::vector<double>& cD, const std::vector<double>& efficiency) {
+    size_t i = 0;
+
+    while (i < cL.size()) {
+        // Skip any pair (cL, cD) where both values are zero (as these points are not useful)
+        if (cL[i] == 0.0 && cD[i] == 0.0) {
+            i++;
+            continue;
+        }
+
+        // Look for a subsequent point that dominates the current one, and continue from it if found
+        size_t next = i;
+        for (size_t j = i + 1; j < cL.size(); ++j) {
+            if (cL[j] > cL[i] && efficiency[j] > efficiency[i]) {
+                next = j;
+                break;
+            }
+        }
+
+        if (next == i) {
+            return i;       // No subsequent point dominates the current one: it is the optimal point
+        }
+        i = next;
+    }
+
+    return cL.size();       // No valid points found
+}
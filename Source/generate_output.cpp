@@ -27,35 +27,46 @@ void writeRecapFile(const std::string& airfoilFile) {
     std::string firstLine;
     readCoordinatesFromFile(airfoilFile, firstLine);
 
-    // Open the output file to write the recap
-    std::ofstream recapFile("Output/optimization_recap.txt");
-
-    if (!recapFile) {
+    // Write the recap with the current configuration and the optimal values found
+    OptimalPoint optimal = {alphaOptimal, cLOptimal, cDOptimal, efficiencyOptimal};
+    if (!writeRecap("Output/optimization_recap.txt", firstLine, chord, cruiseSpeed, kinematicViscosity, reynoldsNumber, optimal)) {
         // Error handling if the file cannot be opened
         std::cerr << "ERROR: Could not open 'optimization_recap.txt'" << std::endl;
         exit(1);
     }
 
+    // Notify the user that the results have been stored
+    std::cout << "\nResults stored in 'optimization_recap.txt'."
+                  << "\n*** Move the file to a safe location to avoid further simulations from overwriting it. ***" << std::endl;
+}
+
+// Function to write a recap file with the given parameters and optimal values
+bool writeRecap(const std::string& recapFilename, const std::string& airfoilName, double chordValue, double speedValue,
+                double viscosityValue, double reynolds, const OptimalPoint& optimal) {
+    // Open the output file to write the recap
+    std::ofstream recapFile(recapFilename);
+
+    if (!recapFile) {
+        return false;
+    }
+
     // Write the optimization results to the file
     recapFile << "\n--- OPTIMIZATION RESULTS ---\n\n";
-    recapFile << "Airfoil model: " << firstLine << "\n\n";
+    recapFile << "Airfoil model: " << airfoilName << "\n\n";
     recapFile << "Parameters:\n";
-    recapFile << "  -Chord: " << chord << "\n";                                     // Write chord length
-    recapFile << "  -Cruise Speed: " << cruiseSpeed << "\n";                        // Write cruise speed
-    recapFile << "  -Kinematic Viscosity: " << kinematicViscosity << "\n";          // Write kinematic viscosity
-    recapFile << "  -Reynolds Number: " << reynoldsNumber << "\n" << std::endl;     // Write Reynolds number
+    recapFile << "  -Chord: " << chordValue << "\n";                                 // Write chord length
+    recapFile << "  -Cruise Speed: " << speedValue << "\n";                          // Write cruise speed
+    recapFile << "  -Kinematic Viscosity: " << viscosityValue << "\n";               // Write kinematic viscosity
+    recapFile << "  -Reynolds Number: " << reynolds << "\n" << std::endl;            // Write Reynolds number
 
     // Write the optimal values obtained from the simulation
     recapFile << "Optimal Values:\n";
-    recapFile << "  -Alpha: " << std::fixed << std::setprecision(3) << alphaOptimal << "\n";              // Write optimal angle of attack
-    recapFile << "  -CL: " << cLOptimal << "\n";                    // Write optimal lift coefficient
-    recapFile << "  -CD: " << cDOptimal << "\n";                    // Write optimal drag coefficient
-    recapFile << "  -L/D: " << efficiencyOptimal << std::endl;      // Write optimal lift-to-drag ratio
-
-    // Notify the user that the results have been stored
-    std::cout << "\nResults stored in 'optimization_recap.txt'."
-                  << "\n*** Move the file to a safe location to avoid further simulations from overwriting it. ***" << std::endl;
+    recapFile << "  -Alpha: " << std::fixed << std::setprecision(3) << optimal.alpha << "\n";     // Write optimal angle of attack
+    recapFile << "  -CL: " << optimal.cL << "\n";                      // Write optimal lift coefficient
+    recapFile << "  -CD: " << optimal.cD << "\n";                      // Write optimal drag coefficient
+    recapFile << "  -L/D: " << optimal.efficiency << std::endl;         // Write optimal lift-to-drag ratio
 
     // Close the file after writing
     recapFile.close();
-}
\ No newline at end of file
+    return true;
+}
@@ -0,0 +1,431 @@
+/*
+    This file implements the watch mode, which keeps the simulation results of the whole airfoil library
+    (every '.dat' file in the Input folder) up to date while designers add or edit coordinates files.
+
+    Each airfoil is identified by a hash of its normalized geometry (points as formatted for xfoil, with
+    coordinates rounded so that re-saving a file does not change it) and of its panel nodes, and its results
+    are stored per (Reynolds number, alpha) point. When a file changes, only the points whose inputs actually
+    changed are simulated again: all of them if the geometry or the panel nodes changed, otherwise only the
+    points missing for the current configuration (e.g. after extending the alpha range), and the points that
+    did not converge with a lower iteration limit than the current one. Missing points are grouped in contiguous alpha
+    ranges and simulated in parallel, and the formatted copies given to xfoil are stored in 'Output/watch',
+    so that the original files are never modified.
+
+    After every update the results are saved in 'library_results.dat', and the cross-airfoil Pareto summary
+    'library_pareto.txt' is rebuilt from the front of each airfoil, so that only the fronts of the updated
+    airfoils are recomputed. While a batch runs, the cross-airfoil front is updated (with a streaming skyline)
+    every time a simulation is completed, and written to 'library_pareto_live.txt', and the simulated points are
+    recorded in the run journal, so that a batch interrupted by a crash does not start from scratch.
+    On Linux, changes are detected with inotify, elsewhere by polling modification times.
+*/
+
+#include "../Header/library_watch.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/panel_convergence.h"
+#include "../Header/streaming_skyline.h"
+#include "../Header/run_journal.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <set>
+#include <limits>
+#include <mutex>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+const std::string libraryResultsFile = "Output/library_results.dat";    // Results of every airfoil of the library
+const std::string libraryParetoFile = "Output/library_pareto.txt";      // Cross-airfoil Pareto summary
+const std::string watchDirectory = "Output/watch";                      // Formatted copies of the airfoils, loaded by xfoil
+const std::string liveParetoFile = "Output/library_pareto_live.txt";    // Cross-airfoil Pareto front while a batch runs
+
+const double geometryResolution = 1.0e-5;       // Resolution of the coordinates used to compute the geometry hash
+const int settleMilliseconds = 300;             // Time waited after a change, so that files are completely written
+
+// Global map to store the library, by file name inside the Input folder
+std::map<std::string, LibraryAirfoil> library;
+
+// Compute a 64-bit FNV-1a hash of the geometry, with the coordinates rounded to the configured resolution,
+// followed by the panel nodes (which change the results as much as the geometry)
+uint64_t hashGeometry(const std::vector<Point>& points, int nodes) {
+    uint64_t hash = 1469598103934665603ULL;
+    auto hashValue = [&hash](int64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash ^= static_cast<uint64_t>(value >> (8 * byte)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (const auto& point : points) {
+        for (double value : {point.x, point.y}) {
+            hashValue(static_cast<int64_t>(std::llround(value / geometryResolution)));
+        }
+    }
+    hashValue(nodes);
+    return hash;
+}
+
+// Helper function to check whether two values (Reynolds number or alpha) refer to the same point
+bool samePointValue(double a, double b) {
+    return std::fabs(a - b) <= 1.0e-6 * std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+}
+
+// Helper function to find a simulated point of an airfoil (end of the points if not simulated yet)
+std::vector<LibraryPoint>::iterator findLibraryPoint(LibraryAirfoil& airfoil, double reynolds, double a) {
+    return std::find_if(airfoil.points.begin(), airfoil.points.end(), [&](const LibraryPoint& point) {
+        return samePointValue(point.reynolds, reynolds) && samePointValue(point.alpha, a);
+    });
+}
+
+// Helper function to check whether a point must be simulated: not simulated yet, or not converged with a lower
+// iteration limit than the current one
+bool needsSimulation(LibraryAirfoil& airfoil, double reynolds, double a) {
+    auto point = findLibraryPoint(airfoil, reynolds, a);
+    return point == airfoil.points.end() || (!point->converged && point->iterations < iterLimit);
+}
+
+// Helper function to compute the non-dominated (CL, L/D) points of the given set
+std::vector<LibraryPoint> nonDominatedPoints(std::vector<LibraryPoint> points) {
+    // Sort by decreasing CL: a point is non-dominated if its L/D is higher than the one of every point before it
+    std::sort(points.begin(), points.end(), [](const LibraryPoint& a, const LibraryPoint& b) { return a.cL > b.cL; });
+
+    std::vector<LibraryPoint> front;
+    double bestEfficiency = -std::numeric_limits<double>::infinity();
+    for (const auto& point : points) {
+        if (point.cL / point.cD > bestEfficiency) {
+            front.push_back(point);
+            bestEfficiency = point.cL / point.cD;
+        }
+    }
+    return front;
+}
+
+// Helper function to recompute the front of an airfoil at the current Reynolds number
+void updateAirfoilFront(LibraryAirfoil& airfoil) {
+    std::vector<LibraryPoint> current;
+    for (const auto& point : airfoil.points) {
+        if (point.converged && samePointValue(point.reynolds, reynoldsNumber)) {
+            current.push_back(point);
+        }
+    }
+    airfoil.front = nonDominatedPoints(current);
+}
+
+// Helper function to save the results of every airfoil.
+// Each airfoil is written as "AIRFOIL <hash> <number of points> <file name>", its name,
+// then one "<Reynolds number> <alpha> <CL> <CD> <converged> <iteration limit>" line per point
+void saveLibrary() {
+    std::ofstream outfile(libraryResultsFile);
+    outfile << std::setprecision(17);
+    for (const auto& entry : library) {
+        outfile << "AIRFOIL " << entry.second.geometryHash << " " << entry.second.points.size() << " " << entry.first << "\n";
+        outfile << entry.second.name << "\n";
+        for (const auto& point : entry.second.points) {
+            outfile << point.reynolds << " " << point.alpha << " " << point.cL << " " << point.cD << " " << point.converged
+                    << " " << point.iterations << "\n";
+        }
+    }
+}
+
+// Helper function to load the results saved by saveLibrary() (missing file means empty library)
+void loadLibrary() {
+    library.clear();
+    std::ifstream infile(libraryResultsFile);
+    std::string line;
+
+    while (std::getline(infile, line)) {
+        std::istringstream header(line);
+        std::string tag, filename;
+        LibraryAirfoil airfoil;
+        size_t numPoints = 0;
+        if (!(header >> tag >> airfoil.geometryHash >> numPoints) || tag != "AIRFOIL") {
+            continue;       // Skip unexpected lines
+        }
+
+        // The file name is the rest of the line (it may contain spaces), without surrounding whitespace
+        std::getline(header >> std::ws, filename);
+        filename.erase(filename.find_last_not_of(" \t\r") + 1);
+        if (filename.empty()) {
+            continue;
+        }
+
+        std::getline(infile, airfoil.name);
+        for (size_t i = 0; i < numPoints && std::getline(infile, line); ++i) {
+            std::istringstream ss(line);
+            LibraryPoint point;
+            if (ss >> point.reynolds >> point.alpha >> point.cL >> point.cD >> point.converged) {
+                if (!(ss >> point.iterations)) {
+                    point.iterations = 0;       // Points saved by older versions: retried if they did not converge
+                }
+                airfoil.points.push_back(point);
+            }
+        }
+
+        updateAirfoilFront(airfoil);
+        library[filename] = airfoil;
+    }
+}
+
+// Helper function to offer the converged points of an airfoil at the current Reynolds number to a skyline
+void offerLibraryPoints(StreamingSkyline& skyline, const std::string& filename, const std::vector<LibraryPoint>& points) {
+    for (const auto& point : points) {
+        if (point.converged && samePointValue(point.reynolds, reynoldsNumber)) {
+            skyline.insert({filename, point.reynolds, point.alpha, point.cL, point.cD, 0.0});
+        }
+    }
+}
+
+// Helper function to write the cross-airfoil Pareto summary, merging the fronts of all the airfoils
+void writeLibraryPareto() {
+    StreamingSkyline skyline;
+    for (const auto& entry : library) {
+        offerLibraryPoints(skyline, entry.first, entry.second.front);
+    }
+    skyline.writeFront(libraryParetoFile, "LIBRARY PARETO FRONT");
+}
+
+// Update the given airfoil files, simulating only the (Reynolds number, alpha) points whose inputs changed
+void updateLibrary(const std::vector<std::string>& filenames) {
+    std::vector<SimulationJob> jobs;
+    std::vector<std::string> jobOwners;         // Airfoil file of each job
+    std::set<std::string> updated;              // Airfoils whose results (or front) must be recomputed
+    std::filesystem::create_directories(watchDirectory);
+
+    size_t numAlphaSteps = static_cast<size_t>((alphaEnd - alphaStart) / alphaIncrement) + 1;
+
+    for (const auto& filename : filenames) {
+        std::string inputPath = "Input/" + filename;
+
+        // Removed files are dropped from the library
+        if (!std::filesystem::exists(inputPath)) {
+            if (library.erase(filename) > 0) {
+                std::cout << "Removed '" << filename << "' from the library." << std::endl;
+                updated.insert(filename);
+            }
+            continue;
+        }
+
+        std::string firstLine;
+        std::vector<Point> points = readCoordinatesFromFile(inputPath, firstLine);
+        if (points.size() < 10) {
+            std::cerr << "Warning: Not enough coordinates to load '" << filename << "', skipped." << std::endl;
+            continue;
+        }
+        std::vector<Point> processed = processAirfoilPoints(points);
+        int nodes = getPanelNodes(inputPath);
+
+        // A different geometry (or discretization) invalidates every point simulated so far
+        LibraryAirfoil& airfoil = library[filename];
+        uint64_t hash = hashGeometry(processed, nodes);
+        if (airfoil.geometryHash != hash || airfoil.points.empty()) {
+            airfoil.points.clear();
+            airfoil.geometryHash = hash;
+        }
+        airfoil.name = firstLine;
+        updated.insert(filename);
+
+        // Group the missing alpha values in contiguous ranges, each one simulated by a job
+        std::string formattedPath = watchDirectory + "/" + filename;
+        bool formattedSaved = false;
+        size_t first = numAlphaSteps;
+        for (size_t i = 0; i <= numAlphaSteps; ++i) {
+            bool missing = i < numAlphaSteps && needsSimulation(airfoil, reynoldsNumber, alphaStart + i * alphaIncrement);
+            if (missing && first == numAlphaSteps) {
+                first = i;      // Start of a missing range
+            }
+            else if (!missing && first < numAlphaSteps) {
+                if (!formattedSaved) {
+                    saveToFile(formattedPath, firstLine, processed);
+                    formattedSaved = true;
+                }
+                SimulationJob job = makeSimulationJob(formattedPath, "watch_" + std::to_string(jobs.size()) + "_polar.dat");
+                job.firstAlpha = alphaStart + first * alphaIncrement;
+                job.lastAlpha = alphaStart + (i - 1) * alphaIncrement;
+                job.warmupPoints = first > 0 ? 1 : 0;      // Start from the last recorded alpha
+                job.nodes = nodes;
+                job.captureSurface = captureSurface;
+                jobs.push_back(job);
+                jobOwners.push_back(filename);
+                first = numAlphaSteps;
+            }
+        }
+    }
+
+    // Simulate all the missing points in parallel, storing also the points that did not converge
+    if (!jobs.empty()) {
+        std::cout << "Simulating " << jobs.size() << " alpha range(s) for " << updated.size() << " airfoil(s)..." << std::endl;
+
+        // Show the cross-airfoil front converging while the batch runs, starting from the points already simulated
+        StreamingSkyline liveFront;
+        for (const auto& entry : library) {
+            offerLibraryPoints(liveFront, entry.first, entry.second.points);
+        }
+        std::mutex progressLock;
+        size_t completed = 0;
+        auto showProgress = [&](size_t j, const PolarResult& polar) {
+            for (size_t i = 0; i < polar.alpha.size(); ++i) {
+                liveFront.insert({jobOwners[j], jobs[j].reynolds, polar.alpha[i], polar.cL[i], polar.cD[i], 0.0});
+            }
+
+            std::lock_guard<std::mutex> guard(progressLock);
+            SkylinePoint best;
+            std::cout << "  [" << ++completed << "/" << jobs.size() << "] front: " << liveFront.size() << " points";
+            if (liveFront.optimum(best)) {
+                std::cout << ", best L/D " << std::fixed << std::setprecision(2) << best.efficiency << std::defaultfloat
+                          << " (" << best.source << ", alpha " << best.alpha << ")";
+            }
+            std::cout << std::endl;
+            liveFront.writeFront(liveParetoFile, "LIBRARY PARETO FRONT (LIVE)");
+        };
+
+        std::vector<PolarResult> results = runSimulationBatch(jobs, simulationWorkers, showProgress);
+
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            LibraryAirfoil& airfoil = library[jobOwners[j]];
+            const PolarResult& polar = results[j];
+
+            for (double a = jobs[j].firstAlpha; a <= jobs[j].lastAlpha + 1.0e-9; a += jobs[j].alphaStep) {
+                LibraryPoint point = {jobs[j].reynolds, a, 0.0, 0.0, false, jobs[j].iterations};
+                for (size_t i = 0; i < polar.alpha.size(); ++i) {
+                    if (std::fabs(polar.alpha[i] - a) < 1.0e-3) {
+                        point = {jobs[j].reynolds, a, polar.cL[i], polar.cD[i], true, jobs[j].iterations};
+                    }
+                }
+
+                // Replace the result of a point retried after not converging
+                auto previous = findLibraryPoint(airfoil, point.reynolds, a);
+                if (previous != airfoil.points.end()) {
+                    *previous = point;
+                }
+                else {
+                    airfoil.points.push_back(point);
+                }
+            }
+        }
+    }
+
+    // Recompute the fronts of the updated airfoils only, then save results and summary
+    for (const auto& filename : updated) {
+        auto found = library.find(filename);
+        if (found != library.end()) {
+            updateAirfoilFront(found->second);
+        }
+    }
+    if (!updated.empty()) {
+        saveLibrary();
+        clearRunJournal();      // The results of the batch are now stored in the library file
+        writeLibraryPareto();
+        std::cout << "Library updated (" << library.size() << " airfoils), summary stored in 'library_pareto.txt'." << std::endl;
+    }
+}
+
+// Helper function to check whether a file name is an airfoil coordinates file
+bool isAirfoilFile(const std::string& filename) {
+    return filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".dat") == 0;
+}
+
+// Helper function to list the airfoil files of the Input folder with their modification time
+std::map<std::string, std::filesystem::file_time_type> scanInputFolder() {
+    std::map<std::string, std::filesystem::file_time_type> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("Input", error)) {
+        std::string filename = entry.path().filename().string();
+        if (entry.is_regular_file() && isAirfoilFile(filename)) {
+            files[filename] = entry.last_write_time(error);
+        }
+    }
+    return files;
+}
+
+// Run the watch mode: update the whole library once, then update the airfoils every time their files change
+void runWatchMode() {
+    loadLibrary();
+    loadPanelNodes("Output/panel_nodes.dat");
+
+    // Points simulated by a batch are saved in the library file only when the whole batch is completed:
+    // until then they are recorded in the journal, so that an update interrupted by a crash is resumed
+    openRunJournal("watch");
+
+    // Initial update: unchanged airfoils are recognized by their geometry hash and not simulated again
+    std::map<std::string, std::filesystem::file_time_type> known = scanInputFolder();
+    std::vector<std::string> filenames;
+    for (const auto& entry : known) {
+        filenames.push_back(entry.first);
+    }
+    for (const auto& entry : library) {
+        if (!known.count(entry.first)) {
+            filenames.push_back(entry.first);       // Removed while not watching
+        }
+    }
+    updateLibrary(filenames);
+
+    std::cout << "\nWatching the 'Input' folder for changes (Ctrl+C to stop)..." << std::endl;
+
+#ifdef __linux__
+    int watcher = inotify_init1(IN_NONBLOCK);
+    if (watcher < 0 || inotify_add_watch(watcher, "Input", IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+        std::cerr << "ERROR: Could not watch the 'Input' folder." << std::endl;
+        return;
+    }
+
+    std::vector<char> buffer(64 * 1024);
+    while (true) {
+        // Wait for a change, then collect all the changes happening in a short time (e.g. a whole folder copy)
+        std::set<std::string> changed;
+        pollfd descriptor = {watcher, POLLIN, 0};
+        int timeout = -1;
+        while (poll(&descriptor, 1, timeout) > 0) {
+            ssize_t length;
+            while ((length = read(watcher, buffer.data(), buffer.size())) > 0) {
+                for (char* p = buffer.data(); p < buffer.data() + length; ) {
+                    inotify_event* event = reinterpret_cast<inotify_event*>(p);
+                    if (event->len > 0 && isAirfoilFile(event->name)) {
+                        changed.insert(event->name);
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            timeout = settleMilliseconds;
+        }
+
+        if (!changed.empty()) {
+            updateLibrary(std::vector<std::string>(changed.begin(), changed.end()));
+        }
+    }
+#else
+    // Without inotify, compare the modification times of the files at regular intervals
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * settleMilliseconds));
+
+        std::map<std::string, std::filesystem::file_time_type> current = scanInputFolder();
+        std::vector<std::string> changed;
+        for (const auto& entry : current) {
+            auto found = known.find(entry.first);
+            if (found == known.end() || found->second != entry.second) {
+                changed.push_back(entry.first);
+            }
+        }
+        for (const auto& entry : known) {
+            if (!current.count(entry.first)) {
+                changed.push_back(entry.first);
+            }
+        }
+        known = current;
+
+        if (!changed.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(settleMilliseconds));
+            updateLibrary(changed);
+        }
+    }
+#endif
+}
@@ -0,0 +1,427 @@
+/*
+    This file implements a nonlinear lifting-line method to estimate the performance of a complete wing,
+    using the section polars computed by xfoil instead of a linear lift slope.
+
+    The spanwise circulation is written as a Fourier sine series, Γ(θ) = 2bV Σ A_n sin(nθ), with the
+    stations placed at y = -(b/2) cos(θ). The induced angle at each station is then a linear function of
+    the circulation values, through an influence matrix that depends only on the number of stations: it is
+    computed once and shared by every analysis. For each wing, the circulation must be consistent with the
+    section polars (interpolated at the local Reynolds number) evaluated at the effective angle of attack of
+    each section, i.e. the geometric angle minus the induced one. This nonlinear system is solved with Newton
+    iterations, using the local lift slope of the polars, which converge in a few steps even with many stations.
+
+    The local Reynolds number of each station is derived from its chord exactly as the global Reynolds number
+    (chord * cruise speed / kinematic viscosity). Wing CL and induced drag come from the Fourier coefficients,
+    while profile drag is integrated from the section polars along the span.
+*/
+
+#include "../Header/lifting_line.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/find_optimal_config.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <thread>
+
+const double pi = std::acos(-1.0);
+
+const int maxLiftingLineIterations = 50;      // Maximum number of Newton iterations for each wing
+const double liftingLineTolerance = 1.0e-9;   // Convergence threshold on the nondimensional circulation residual
+
+// Matrices of the lifting-line method, depending only on the number of stations
+struct LiftingLineMatrices {
+    int n;                              // Number of stations
+    std::vector<double> theta;          // Angular coordinate of each station
+    std::vector<double> inverseSine;    // Inverse of S (S_kn = sin(n θ_k)), giving the Fourier coefficients (n x n, row-major)
+    std::vector<double> influence;      // Induced angle influence matrix D * S^-1 (D_kn = n sin(n θ_k) / sin(θ_k))
+};
+
+// Helper function to invert a square matrix (row-major) with Gauss-Jordan elimination and partial pivoting
+std::vector<double> invertMatrix(std::vector<double> a, int n) {
+    std::vector<double> inverse(n * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        inverse[i * n + i] = 1.0;
+    }
+
+    for (int col = 0; col < n; ++col) {
+        // Move the row with the largest pivot in place
+        int pivot = col;
+        for (int row = col + 1; row < n; ++row) {
+            if (std::fabs(a[row * n + col]) > std::fabs(a[pivot * n + col])) pivot = row;
+        }
+        for (int k = 0; k < n; ++k) {
+            std::swap(a[col * n + k], a[pivot * n + k]);
+            std::swap(inverse[col * n + k], inverse[pivot * n + k]);
+        }
+
+        // Normalize the pivot row and eliminate the column from every other row
+        double scale = 1.0 / a[col * n + col];
+        for (int k = 0; k < n; ++k) {
+            a[col * n + k] *= scale;
+            inverse[col * n + k] *= scale;
+        }
+        for (int row = 0; row < n; ++row) {
+            double factor = a[row * n + col];
+            if (row == col || factor == 0.0) continue;
+            for (int k = 0; k < n; ++k) {
+                a[row * n + k] -= factor * a[col * n + k];
+                inverse[row * n + k] -= factor * inverse[col * n + k];
+            }
+        }
+    }
+
+    return inverse;
+}
+
+// Helper function to build the lifting-line matrices for the configured number of stations.
+// They are built only once (thread-safe initialization of the static variable) and shared by every analysis
+const LiftingLineMatrices& getLiftingLineMatrices() {
+    static const LiftingLineMatrices matrices = []() {
+        LiftingLineMatrices m;
+        m.n = liftingLineStations;
+        int n = m.n;
+
+        // Stations at θ_k = kπ/(n+1), excluding the tips where the circulation is zero
+        std::vector<double> sine(n * n), derivative(n * n);
+        for (int k = 0; k < n; ++k) {
+            m.theta.push_back((k + 1) * pi / (n + 1));
+            for (int j = 0; j < n; ++j) {
+                sine[k * n + j] = std::sin((j + 1) * m.theta[k]);
+                derivative[k * n + j] = (j + 1) * sine[k * n + j] / std::sin(m.theta[k]);
+            }
+        }
+
+        // Influence matrix: induced angles = D * S^-1 * (nondimensional circulation)
+        m.inverseSine = invertMatrix(sine, n);
+        m.influence.assign(n * n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < n; ++k) {
+                double d = derivative[i * n + k];
+                for (int j = 0; j < n; ++j) {
+                    m.influence[i * n + j] += d * m.inverseSine[k * n + j];
+                }
+            }
+        }
+        return m;
+    }();
+
+    return matrices;
+}
+
+// Create a trapezoidal planform, with chord and twist varying linearly from root to tip
+Planform makeTrapezoidalPlanform(double span, double rootChord, double taperRatio, double tipTwist) {
+    return {span, {rootChord, rootChord * taperRatio}, {0.0, tipTwist}};
+}
+
+// Helper function to interpolate a planform distribution (given from root to tip) at the spanwise position eta = |2y/b|
+double interpolatePlanform(const std::vector<double>& values, double eta) {
+    if (values.size() == 1) {
+        return values.front();
+    }
+    double position = std::min(eta, 1.0) * (values.size() - 1);
+    size_t i = std::min(static_cast<size_t>(position), values.size() - 2);
+    return values[i] + (values[i + 1] - values[i]) * (position - i);
+}
+
+// Helper function to interpolate a polar quantity at the given alpha (alpha values sorted in increasing order).
+// Below the polar range the values are extrapolated linearly, above it they are held constant
+double interpolatePolar(const std::vector<double>& alphaValues, const std::vector<double>& values, double a) {
+    if (values.size() == 1) {
+        return values.front();
+    }
+    if (a >= alphaValues.back()) {
+        return values.back();
+    }
+
+    size_t i = std::upper_bound(alphaValues.begin(), alphaValues.end(), a) - alphaValues.begin();
+    i = std::min(std::max<size_t>(i, 1), alphaValues.size() - 1);
+    double t = (a - alphaValues[i - 1]) / (alphaValues[i] - alphaValues[i - 1]);
+    return values[i - 1] + (values[i] - values[i - 1]) * t;
+}
+
+// Section data at a spanwise station: the two polars bracketing the local Reynolds number and their weights
+struct StationSection {
+    const PolarResult* low;
+    const PolarResult* high;
+    double weight;      // Weight of the 'high' polar
+    double cLMax;       // Maximum CL of the section at the local Reynolds number
+
+    double cL(double a) const {
+        return (1.0 - weight) * interpolatePolar(low->alpha, low->cL, a) + weight * interpolatePolar(high->alpha, high->cL, a);
+    }
+    double slope(double a) const {      // Lift slope [1/deg], never negative to keep the Newton iterations stable
+        return std::max(0.0, (cL(a + 0.05) - cL(a - 0.05)) / 0.1);
+    }
+    double cD(double a) const {
+        return (1.0 - weight) * interpolatePolar(low->alpha, low->cD, a) + weight * interpolatePolar(high->alpha, high->cD, a);
+    }
+};
+
+// Helper function to set up the section data at the given Reynolds number (clamped to the range of the polars)
+StationSection makeStationSection(const SectionPolars& sections, double reynolds) {
+    size_t i = std::upper_bound(sections.reynolds.begin(), sections.reynolds.end(), reynolds) - sections.reynolds.begin();
+    StationSection station;
+
+    if (i == 0 || i == sections.reynolds.size()) {
+        size_t j = (i == 0) ? 0 : i - 1;
+        station = {&sections.polars[j], &sections.polars[j], 0.0, 0.0};
+    }
+    else {
+        double weight = (reynolds - sections.reynolds[i - 1]) / (sections.reynolds[i] - sections.reynolds[i - 1]);
+        station = {&sections.polars[i - 1], &sections.polars[i], weight, 0.0};
+    }
+
+    station.cLMax = (1.0 - station.weight) * *std::max_element(station.low->cL.begin(), station.low->cL.end())
+                  + station.weight * *std::max_element(station.high->cL.begin(), station.high->cL.end());
+    return station;
+}
+
+// Helper function running the nonlinear lifting-line iterations.
+// 'g' is the nondimensional circulation (Γ / 2bV) at each station: it is used as starting guess and updated
+WingResult solveLiftingLine(const WingCase& wing, std::vector<double>& g) {
+    const LiftingLineMatrices& m = getLiftingLineMatrices();
+    const Planform& planform = *wing.planform;
+    const double b = planform.span;
+    const int n = m.n;
+
+    WingResult result = {wing.alpha, 0.0, 0.0, 0.0, 0.0, 0.0, false};
+    if (wing.sections->polars.empty() || b <= 0.0) {
+        return result;
+    }
+
+    // Wing area (trapezoidal integration of the chord from root to tip, on both halves of the wing)
+    double area = 0.0;
+    for (size_t i = 0; i + 1 < planform.chord.size(); ++i) {
+        area += (planform.chord[i] + planform.chord[i + 1]) * b / (2.0 * (planform.chord.size() - 1));
+    }
+    if (planform.chord.size() == 1) {
+        area = planform.chord.front() * b;
+    }
+    double aspectRatio = b * b / area;
+
+    // Geometry and section data of each station (local Reynolds number derived like the global one)
+    std::vector<double> c(n), twist(n);
+    std::vector<StationSection> sections(n);
+    for (int k = 0; k < n; ++k) {
+        double eta = std::fabs(std::cos(m.theta[k]));
+        c[k] = interpolatePlanform(planform.chord, eta);
+        twist[k] = interpolatePlanform(planform.twist, eta);
+        sections[k] = makeStationSection(*wing.sections, (c[k] * cruiseSpeed) / kinematicViscosity);
+    }
+
+    if (g.size() != static_cast<size_t>(n)) {
+        g.assign(n, 0.0);
+    }
+
+    // Newton iterations on the residual F_k = g_k - c_k cl_k(effective alpha) / 4b, where Γ = V c cl / 2
+    std::vector<double> effectiveAlpha(n), sectionCL(n), residual(n), jacobian(n * n);
+    for (int iteration = 0; iteration < maxLiftingLineIterations && !result.converged; ++iteration) {
+        double size = 1.0e-3;       // Scale of the circulation, used for a relative convergence check
+        double change = 0.0;
+
+        for (int k = 0; k < n; ++k) {
+            // Induced angle and effective angle of attack of the section
+            double inducedAngle = 0.0;
+            for (int j = 0; j < n; ++j) {
+                inducedAngle += m.influence[k * n + j] * g[j];
+            }
+            effectiveAlpha[k] = wing.alpha + twist[k] - inducedAngle * 180.0 / pi;
+            sectionCL[k] = sections[k].cL(effectiveAlpha[k]);
+            residual[k] = g[k] - c[k] * sectionCL[k] / (4.0 * b);
+            size = std::max(size, std::fabs(g[k]));
+
+            // Jacobian row: dF_k/dg_j = δ_kj + c_k/(4b) * dcl/dα * dα_i/dg_j  (angles in radians)
+            double factor = c[k] / (4.0 * b) * sections[k].slope(effectiveAlpha[k]) * 180.0 / pi;
+            for (int j = 0; j < n; ++j) {
+                jacobian[k * n + j] = factor * m.influence[k * n + j] + (k == j ? 1.0 : 0.0);
+            }
+        }
+
+        // Solve J * delta = residual with Gaussian elimination (partial pivoting) and update the circulation
+        for (int col = 0; col < n; ++col) {
+            int pivot = col;
+            for (int row = col + 1; row < n; ++row) {
+                if (std::fabs(jacobian[row * n + col]) > std::fabs(jacobian[pivot * n + col])) pivot = row;
+            }
+            if (pivot != col) {
+                for (int j = col; j < n; ++j) std::swap(jacobian[col * n + j], jacobian[pivot * n + j]);
+                std::swap(residual[col], residual[pivot]);
+            }
+            for (int row = col + 1; row < n; ++row) {
+                double factor = jacobian[row * n + col] / jacobian[col * n + col];
+                for (int j = col; j < n; ++j) jacobian[row * n + j] -= factor * jacobian[col * n + j];
+                residual[row] -= factor * residual[col];
+            }
+        }
+        for (int k = n - 1; k >= 0; --k) {
+            for (int j = k + 1; j < n; ++j) residual[k] -= jacobian[k * n + j] * residual[j];
+            residual[k] /= jacobian[k * n + k];
+            g[k] -= residual[k];
+            change = std::max(change, std::fabs(residual[k]));
+        }
+
+        result.converged = change <= liftingLineTolerance * size;
+    }
+
+    // Section lift coefficients consistent with the final circulation
+    for (int k = 0; k < n; ++k) {
+        double inducedAngle = 0.0;
+        for (int j = 0; j < n; ++j) {
+            inducedAngle += m.influence[k * n + j] * g[j];
+        }
+        effectiveAlpha[k] = wing.alpha + twist[k] - inducedAngle * 180.0 / pi;
+        sectionCL[k] = sections[k].cL(effectiveAlpha[k]);
+    }
+
+    // Fourier coefficients of the circulation: CL = π AR A1, CDi = π AR Σ n An^2
+    for (int i = 0; i < n; ++i) {
+        double coefficient = 0.0;
+        for (int j = 0; j < n; ++j) {
+            coefficient += m.inverseSine[i * n + j] * g[j];
+        }
+        if (i == 0) {
+            result.cL = pi * aspectRatio * coefficient;
+        }
+        result.cDi += pi * aspectRatio * (i + 1) * coefficient * coefficient;
+    }
+
+    // Profile drag and stall margin along the span (dy = (b/2) sin(θ) dθ)
+    result.stallMargin = sections[0].cLMax - sectionCL[0];
+    for (int k = 0; k < n; ++k) {
+        result.cDp += c[k] * sections[k].cD(effectiveAlpha[k]) * 0.5 * b * std::sin(m.theta[k]) * pi / (n + 1) / area;
+        result.stallMargin = std::min(result.stallMargin, sections[k].cLMax - sectionCL[k]);
+    }
+    result.efficiency = result.cL / (result.cDi + result.cDp);
+
+    return result;
+}
+
+// Analyze a wing with the nonlinear lifting-line method, starting from zero circulation
+WingResult solveLiftingLine(const WingCase& wing) {
+    std::vector<double> g;
+    return solveLiftingLine(wing, g);
+}
+
+// Analyze a batch of wings, with worker threads picking short runs of consecutive cases from a shared counter
+std::vector<WingResult> solveLiftingLineBatch(const std::vector<WingCase>& wings, unsigned int workers) {
+    const size_t runLength = 8;     // Consecutive cases taken at once, so that an alpha sweep keeps warm-starting
+    std::vector<WingResult> results(wings.size());
+    std::atomic<size_t> nextRun(0);
+
+    getLiftingLineMatrices();       // Build the shared matrices before starting the workers
+
+    auto worker = [&]() {
+        std::vector<double> g;      // Circulation of the last converged case, used as starting guess for the next one
+        const Planform* lastPlanform = nullptr;
+        const SectionPolars* lastSections = nullptr;
+        for (size_t start = runLength * nextRun++; start < wings.size(); start = runLength * nextRun++) {
+            for (size_t i = start; i < std::min(start + runLength, wings.size()); ++i) {
+                // Only cases of the same wing reuse the circulation (a different wing starts from zero)
+                if (wings[i].planform != lastPlanform || wings[i].sections != lastSections) {
+                    g.clear();
+                }
+                std::vector<double> converged = g;
+                results[i] = solveLiftingLine(wings[i], g);
+                if (!results[i].converged) {
+                    g.swap(converged);      // Never seed the next case from a diverged distribution
+                }
+                lastPlanform = wings[i].planform;
+                lastSections = wings[i].sections;
+            }
+        }
+    };
+
+    workers = static_cast<unsigned int>(std::min<size_t>(std::max(workers, 1u), std::max<size_t>((wings.size() + runLength - 1) / runLength, 1)));
+    std::vector<std::thread> threads;
+    for (unsigned int w = 0; w < workers; ++w) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return results;
+}
+
+// Find the root angle of attack (within the configured alpha range) giving the best wing lift-to-drag ratio
+WingResult findBestWingConfig(const Planform& planform, const SectionPolars& sections) {
+    std::vector<WingCase> wings;
+    for (double a = alphaStart; a <= alphaEnd + 1.0e-9; a += alphaIncrement) {
+        wings.push_back({&planform, &sections, a});
+    }
+
+    WingResult best = {alphaStart, 0.0, 0.0, 0.0, 0.0, 0.0, false};
+    for (const WingResult& result : solveLiftingLineBatch(wings, simulationWorkers)) {
+        if (result.converged && result.cL > 0.0 && (!best.converged || result.efficiency > best.efficiency)) {
+            best = result;
+        }
+    }
+
+    return best;
+}
+
+// Compute the section polars needed by a planform and run the wing analysis of the current airfoil
+void runWingAnalysis(const std::string& airfoilFile) {
+    // Ask the user for the planform (the root chord is the chord used for the 2D simulation)
+    double span = getPositiveInput("\nEnter wing span (m): ");
+    double taperRatio = getPositiveInput("Enter taper ratio (tip chord / root chord): ");
+    Planform planform = makeTrapezoidalPlanform(span, chord, taperRatio, tipTwist);
+
+    // Step 1: Compute the section polars at Reynolds numbers evenly spread between tip and root chords
+    double reynoldsTip = (chord * taperRatio * cruiseSpeed) / kinematicViscosity;
+    int polarCount = (taperRatio == 1.0) ? 1 : wingPolarCount;
+    std::vector<SimulationJob> jobs;
+    for (int i = 0; i < polarCount; ++i) {
+        double t = polarCount > 1 ? static_cast<double>(i) / (polarCount - 1) : 0.0;
+        jobs.push_back(makeSimulationJob(airfoilFile, "wing_" + std::to_string(i) + "_polar.dat"));
+        jobs.back().reynolds = reynoldsTip + (reynoldsNumber - reynoldsTip) * t;
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const SimulationJob& a, const SimulationJob& b) { return a.reynolds < b.reynolds; });
+
+    std::cout << "\nComputing section polars at " << polarCount << " Reynolds number(s)..." << std::endl;
+    std::vector<PolarResult> results = runSimulationBatch(jobs, simulationWorkers);
+
+    SectionPolars sections;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (findOptimalIndex(results[i].cL, results[i].cD, results[i].efficiency) < results[i].cL.size()) {
+            sections.reynolds.push_back(jobs[i].reynolds);
+            sections.polars.push_back(results[i]);
+        }
+    }
+    if (sections.polars.empty()) {
+        std::cerr << "\nERROR: Convergence failed for every section polar." << std::endl;
+        return;
+    }
+
+    // Step 2: Find the best wing configuration and display it
+    WingResult best = findBestWingConfig(planform, sections);
+    if (!best.converged) {
+        std::cerr << "\nERROR: Lifting-line iterations did not converge." << std::endl;
+        return;
+    }
+
+    std::ofstream recapFile("Output/wing_recap.txt");
+    for (std::ostream* out : {static_cast<std::ostream*>(&std::cout), static_cast<std::ostream*>(&recapFile)}) {
+        *out << "\n--- WING ANALYSIS ---\n\n";
+        *out << "Planform:\n";
+        *out << "  -Span: " << span << " m\n";
+        *out << "  -Root Chord: " << chord << " m\n";
+        *out << "  -Taper Ratio: " << taperRatio << "\n";
+        *out << "  -Tip Twist: " << tipTwist << " deg\n";
+        *out << "  -Reynolds Number: " << reynoldsTip << " (tip) - " << reynoldsNumber << " (root)\n\n";
+        *out << "Best L/D Values:\n" << std::fixed << std::setprecision(4);
+        *out << "  -Root Alpha: " << best.alpha << "\n";
+        *out << "  -CL: " << best.cL << "\n";
+        *out << "  -CDi: " << best.cDi << "\n";
+        *out << "  -CDp: " << best.cDp << "\n";
+        *out << "  -L/D: " << best.efficiency << "\n";
+        *out << "  -Stall Margin (section CL): " << best.stallMargin << "\n" << std::defaultfloat << std::flush;
+    }
+
+    std::cout << "\nResults stored in 'wing_recap.txt'." << std::endl;
+}
@@ -5,30 +5,49 @@
 
     xfoil is controlled through command-line inputs, and this function automates the process 
     of loading the airfoil and configuring the panel nodes for further analysis.
+    The commands are compiled once as a script template (see xfoil_script.cpp) and sent in a single write.
 */
 
 #include "../Header/load_airfoil.h"
 #include "../Header/control_xfoil.h"
+#include "../Header/xfoil_script.h"
 #include "../Header/config_settings.h"
+#include "../Header/panel_convergence.h"
 
 #include <iostream>
 #include <cstdio>   
 #include <cstdlib>  
 
 // Function to load an airfoil file and configure it in xfoil.
-// This function sends a sequence of commands to xfoil to load an airfoil file
-// and adjust panel nodes for analysis. The commands are sent via the function sendCommandToXfoil().
+// This function loads the airfoil in the global xfoil process, using the panel nodes chosen by the convergence
+// study for this airfoil (or the default value defined in config_settings.h, if no study has been run)
 void loadAirfoilToXfoil(const std::string& formattedFileName) {
-    // Send the command to load the specified airfoil file in XFOIL
-    sendCommandToXfoil("load " + formattedFileName);        // Load airfoil in xfoil
+    loadAirfoilToXfoil(xfoil, formattedFileName, getPanelNodes(formattedFileName));
+}
 
-    // Enter the panel parameter settings in xfoil to modify panel nodes
-    sendCommandToXfoil("ppar");                             // Enter panel mode
-    sendCommandToXfoil("n " + std::to_string(panelNodes));  // Set the number of panel nodes (defined in config_settings.h)
+// Script loading an airfoil file and setting the panel nodes:
+//   load <file>        Load airfoil in xfoil
+//   ppar               Enter panel mode
+//   n <nodes>          Set the number of panel nodes
+//   (enter)            Confirm changes (empty line simulates Enter key)
+//   (enter)            Back to main menu
+const XfoilScript loadScript = compileXfoilScript("load {airfoil}\nppar\nn {nodes}\n\n\n", {"airfoil", "nodes"});
 
-    // Press "Enter" to confirm the panel settings
-    sendCommandToXfoil("");                                 // Confirm changes (empty string simulates Enter key)
+// Function to load an airfoil file and configure it in the given xfoil process.
+// The compiled script is rendered with the file name and panel nodes, then sent to xfoil in a single write
+void loadAirfoilToXfoil(FILE* process, const std::string& formattedFileName, int nodes) {
+    thread_local std::string commands;      // Reused by every airfoil loaded from this thread
+    renderXfoilScript(loadScript, {formattedFileName, std::to_string(nodes)}, commands);
+    sendScriptToXfoil(process, commands);
+}
 
-    // Press "Enter" again to return to the main menu
-    sendCommandToXfoil("");                                 // Back to main menu
-}
\ No newline at end of file
+// Script generating a NACA airfoil with the xfoil built-in generator, then setting the panel nodes as loadScript does:
+//   naca <digits>      Generate the NACA 4 or 5-digit airfoil (5-digit ones only with standard 210-250 mean lines)
+const XfoilScript nacaScript = compileXfoilScript("naca {digits}\nppar\nn {nodes}\n\n\n", {"digits", "nodes"});
+
+// Function to generate a NACA airfoil in the given xfoil process, so that no coordinates file is written
+void loadNacaToXfoil(FILE* process, const std::string& nacaCode, int nodes) {
+    thread_local std::string commands;
+    renderXfoilScript(nacaScript, {nacaCode, std::to_string(nodes)}, commands);
+    sendScriptToXfoil(process, commands);
+}
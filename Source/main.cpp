@@ -8,9 +8,15 @@
         2. Prompt the user for the airfoil coordinates file name and format the file
         3. Allow the user to modify configuration settings
         4. Load the airfoil into XFOIL, run the simulation, and store results
+           (skipped if the same shape has already been solved at the same Reynolds number),
+           choosing the number of panel nodes with a convergence study the first time an airfoil is simulated
         5. Build a Pareto front and find the optimal configuration
         6. Write a recap of the optimization results to an output file
-        7. Provide options to repeat simulations, load different airfoils, or exit the program.
+        7. Provide options to repeat simulations, load different airfoils, run further analyses or exit the program.
+
+    When started with the '--watch' option, the program instead keeps the results of every airfoil
+    in the Input folder up to date, re-running only what changed (see library_watch.cpp).
+    With '--capture', the surface distributions of every simulation are also stored (see surface_data.cpp).
  */
 
 #include "../Header/format_airfoil.h"
@@ -22,16 +28,101 @@
 #include "../Header/build_pareto_front.h"
 #include "../Header/find_optimal_config.h"
 #include "../Header/generate_output.h"
+#include "../Header/shape_index.h"
+#include "../Header/robustness_analysis.h"
+#include "../Header/panel_convergence.h"
+#include "../Header/lifting_line.h"
+#include "../Header/library_watch.h"
+#include "../Header/sensitivity_analysis.h"
+#include "../Header/distributed_simulation.h"
+#include "../Header/airfoil_family.h"
+#include "../Header/surface_data.h"
 
 #include <iostream>
 #include <vector>
+#include <cstdlib>
+#include <cstdio>
 
 // Function to display the starting page with program instructions
 void showStartingPage();
 
-int main() {
+// File storing the shapes (and their polars) solved in previous runs
+const std::string shapeIndexFile = "Output/shape_index.dat";
+
+// File storing the panel node counts chosen by the convergence study in previous runs
+const std::string panelNodesFile = "Output/panel_nodes.dat";
+
+// Number of neighbours used to estimate the polar of a new airfoil
+const size_t estimateNeighbours = 3;
+
+int main(int argc, char* argv[]) {
+    // Read the command line options
+    bool watchMode = false;
+    bool familyMode = false;
+    FamilySpec family;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--watch") {
+            watchMode = true;
+        }
+        else if (option == "--coordinator" && i + 1 < argc) {
+            coordinatorPort = std::atoi(argv[++i]);     // Batches are handed to the workers connected to this port
+        }
+        else if (option == "--bind" && i + 1 < argc) {
+            coordinatorAddress = argv[++i];             // Accept workers on this address (e.g. 0.0.0.0 for every interface)
+        }
+        else if (option == "--worker" && i + 2 < argc) {
+            runSimulationWorker(argv[i + 1], std::atoi(argv[i + 2]));     // Run simulations for a coordinator
+            return 0;
+        }
+        else if (option == "--capture") {
+            captureSurface = true;      // Store the surface distributions of every simulation
+        }
+        else if (option == "--surface" && i + 3 < argc) {
+            // Print a stored surface distribution: airfoil name, Reynolds number and alpha
+            if (!showSurfaceDistribution(argv[i + 1], std::atof(argv[i + 2]), std::atof(argv[i + 3]))) {
+                std::cerr << "No surface data stored for '" << argv[i + 1] << "' at Re " << argv[i + 2]
+                          << ", alpha " << argv[i + 3] << "." << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        else if (option == "--family") {
+            // The family type and its parameter ranges are the arguments up to the next option
+            std::vector<std::string> arguments;
+            while (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+                arguments.push_back(argv[++i]);
+            }
+            familyMode = parseFamilySpec(arguments, family);
+            if (!familyMode) {
+                std::cerr << "Invalid family. Examples: naca4 0:4:2 4 9:15:3, naca5 2 1:5:1 0:1:1 12, naca6 3:5:1 2 12, cst 0.1:0.2:0.05 -0.1" << std::endl;
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Usage: airfoil_optimization [--watch | --family <type> <ranges>] [--capture] [--coordinator <port> [--bind <address>]] | [--worker <host> <port>]"
+                      << " | [--surface <airfoil> <reynolds> <alpha>]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Family sweep: simulate every member of a parametric family, without user interaction
+    if (familyMode) {
+        runFamilySweep(family);
+        return 0;
+    }
+
+    // Watch mode: keep the results of the whole Input folder up to date, without user interaction
+    if (watchMode) {
+        runWatchMode();
+        return 0;
+    }
+
     showStartingPage();         // Display the initial instructions and program title
 
+    loadShapeIndex(shapeIndexFile);     // Load the shapes solved in previous runs
+    loadPanelNodes(panelNodesFile);     // Load the panel node counts chosen in previous runs
+
     std::string filename;       // Variable to store the name of the airfoil coordinates file entered by the user
 
     int userChoice = -1;        // Variable to store the user's choice of action
@@ -57,48 +148,123 @@ int main() {
         // Show current variable values and configuration menu, allowing the user to modify them
         modifyConfiguration();
 
-        openXfoil();        // Open the xfoil simulation environment
+        // Compute the normalized shape signature of the airfoil, used to look for already solved shapes
+        std::string airfoilName;
+        std::vector<double> signature = computeShapeSignature(readCoordinatesFromFile("Input/" + filename, airfoilName));
 
-        // Load the formatted airfoil coordinates into xfoil and configure panel nodes
-        loadAirfoilToXfoil("Input/" + filename);
+        // Choose the number of panel nodes for this airfoil, if not already done in previous runs
+        if (!hasPanelNodes("Input/" + filename)) {
+            runPanelConvergenceStudy("Input/" + filename);
+            savePanelNodes(panelNodesFile);
+        }
+
+        // Stored polars are reused only if computed with the same solver inputs
+        std::string settings = solverSettingsKey(getPanelNodes("Input/" + filename), iterLimit, alphaStart, alphaEnd, alphaIncrement);
+
+        bool solved = true;         // Whether results are available (a failed simulation does not terminate the program)
+        const StoredPolar* duplicate = findDuplicatePolar(signature, reynoldsNumber, settings);
+        if (duplicate) {
+            // The same shape has already been solved with the same inputs: reuse its polar and skip xfoil
+            std::cout << "\nShape already solved at this Reynolds number, reusing stored polar." << std::endl;
+            storePolarResults(duplicate->alpha, duplicate->cL, duplicate->cD);
+        }
+        else {
+            // Show the estimate given by the closest shapes already solved, while waiting for xfoil
+            StoredPolar estimate;
+            if (estimatePolarFromNeighbours(signature, reynoldsNumber, estimateNeighbours, estimate)) {
+                size_t best = 0;
+                for (size_t i = 1; i < estimate.alpha.size(); ++i) {
+                    if (estimate.cL[i] / estimate.cD[i] > estimate.cL[best] / estimate.cD[best]) best = i;
+                }
+                std::cout << "\nEstimate from similar airfoils: max L/D " << estimate.cL[best] / estimate.cD[best]
+                          << " at alpha " << estimate.alpha[best] << std::endl;
+            }
 
-        // Launch simulation in xfoil for the loaded airfoil with confirmed configuration variables
-        runSimulation();
+            std::remove(("Output/" + simDataFile).c_str());     // Remove old results, so that a failed run cannot return them
+            openXfoil();        // Open the xfoil simulation environment
 
-        closeXfoil();       // Close xfoil after simulation completion
+            // Load the formatted airfoil coordinates into xfoil and configure panel nodes
+            loadAirfoilToXfoil("Input/" + filename);
 
-        // Read and store simulation values for angle of attack (alpha), lift coefficient (CL), drag coefficient (CD)
-        storeSimulationResults();
+            // Launch simulation in xfoil for the loaded airfoil with confirmed configuration variables
+            runSimulation();
 
-        // Build the Pareto front of CL and L/D values from the simulation results
-        buildParetoFront(alpha, cL, cD);
+            closeXfoil();       // Close xfoil after simulation completion
 
-        // Find the optimal combination of CL and L/D values within the Pareto front
-        findOptimalConfig();
+            // Read and store simulation values for angle of attack (alpha), lift coefficient (CL), drag coefficient (CD)
+            size_t stored = storeSimulationResults();
+            solved = (stored > 0);
 
-        // Generate an output file summarizing the parameters used in the simulation and optimization results
-        writeRecapFile("Input/" + filename);
-        
-        // Prompt user for next action
-        std::cout << "\nWhat would you like to do next?\n";
-        std::cout << "  0. Close the program\n";
-        std::cout << "  1. Repeat simulation\n";
-        std::cout << "  2. Load different airfoil\n";
+            // Store the surface distributions of the converged alpha values, if requested
+            if (solved && captureSurface) {
+                std::string polarPath = "Output/" + simDataFile;
+                appendSurfaceRecords(collectSurfaceRecords(airfoilName, reynoldsNumber, surfaceFilesPrefix(polarPath),
+                                                           alphaStart, alphaEnd, alphaIncrement, polarPath));
+            }
+
+            // Add the solved polar (the converged points just stored) to the shape index and save it for future runs
+            if (solved) {
+                StoredPolar polar = {reynoldsNumber, {}, {}, {}, settings};
+                for (size_t i = 0; i < stored; ++i) {
+                    polar.alpha.push_back(alpha[i]);
+                    polar.cL.push_back(cL[i]);
+                    polar.cD.push_back(cD[i]);
+                }
+                addShapeToIndex(airfoilName, signature, polar);
+                appendShapeIndex(shapeIndexFile, airfoilName, signature, polar);
+            }
+        }
+
+        if (solved) {
+            // Build the Pareto front of CL and L/D values from the simulation results
+            buildParetoFront(alpha, cL, cD);
 
+            // Find the optimal combination of CL and L/D values within the Pareto front
+            findOptimalConfig();
+
+            // Generate an output file summarizing the parameters used in the simulation and optimization results
+            writeRecapFile("Input/" + filename);
+        }
+        else {
+            std::cerr << "No results to optimize: change the configuration (e.g. alpha range or iteration limit) and repeat the simulation." << std::endl;
+        }
+        
+        // Prompt user for next action (analyses return to this menu once completed)
         do {
-            isValidChoice = true;
-            std::cout << "Choose an option: ";
-            std::cin >> input;    // Read user input as a string
-
-            // Validate user input and convert it to an integer only if valid
-            if (input == "0" || input == "1" || input == "2") {
-                userChoice = std::stoi(input);  // Convert string input to an integer
-            } 
-            else {
-                std::cerr << "Invalid input. Please provide a valid option (0-2).\n" << std::endl;
-                isValidChoice = false;          // Invalid input, continue the loop
+            std::cout << "\nWhat would you like to do next?\n";
+            std::cout << "  0. Close the program\n";
+            std::cout << "  1. Repeat simulation\n";
+            std::cout << "  2. Load different airfoil\n";
+            std::cout << "  3. Run manufacturing robustness analysis\n";
+            std::cout << "  4. Estimate 3D wing performance\n";
+            std::cout << "  5. Run sensitivity analysis\n";
+
+            do {
+                isValidChoice = true;
+                std::cout << "Choose an option: ";
+                std::cin >> input;    // Read user input as a string
+
+                // Validate user input and convert it to an integer only if valid
+                if (input.size() == 1 && input[0] >= '0' && input[0] <= '5') {
+                    userChoice = std::stoi(input);  // Convert string input to an integer
+                } 
+                else {
+                    std::cerr << "Invalid input. Please provide a valid option (0-5).\n" << std::endl;
+                    isValidChoice = false;          // Invalid input, continue the loop
+                }
+            } while(!isValidChoice);
+
+            // Run the chosen analysis on the current airfoil
+            if (userChoice == 3) {
+                runRobustnessAnalysis("Input/" + filename);
+            }
+            else if (userChoice == 4) {
+                runWingAnalysis("Input/" + filename);
+            }
+            else if (userChoice == 5) {
+                runSensitivityAnalysis("Input/" + filename);
             }
-        } while(!isValidChoice);
+        } while(userChoice >= 3);
         
         // If the user chooses to exit, print a closing message
         if(userChoice == 0) {
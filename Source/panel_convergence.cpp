@@ -0,0 +1,153 @@
+/*
+    This file implements an automated panel convergence study, used to choose the number of panel nodes
+    of each airfoil. Too many panels waste solver time, while too few give wrong results (especially drag
+    on aft-loaded sections), and the best compromise depends on the shape of the airfoil.
+
+    The airfoil is simulated at a few probe angles of attack for every candidate panel count, all in parallel.
+    The finest discretization is taken as reference, and the chosen count is the smallest one for which
+    the current and all finer counts give CL and CD within the configured relative tolerance of the reference.
+
+    The chosen counts are stored in 'panel_nodes.dat' by airfoil contents (not by file name, so editing a file
+    invalidates its count) and Reynolds number, and used by loadAirfoilToXfoil() and by batch simulations in
+    place of the default panel nodes value.
+*/
+
+#include "../Header/panel_convergence.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+
+// Global map to store the panel node count chosen for each airfoil (by key)
+std::map<std::string, int> panelNodesByAirfoil;
+
+// Get the key of an airfoil: 64-bit FNV-1a hash of its file contents, and rounded Reynolds number
+std::string panelNodesKey(const std::string& airfoilFile, double reynolds) {
+    std::ifstream infile(airfoilFile, std::ios::binary);
+    uint64_t hash = 1469598103934665603ULL;
+    char c;
+    while (infile.get(c)) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+
+    char key[48];
+    snprintf(key, sizeof(key), "%016llx %lld", static_cast<unsigned long long>(hash), static_cast<long long>(std::llround(reynolds)));
+    return key;
+}
+
+// Helper function to check whether a polar matches the reference one at every probe alpha
+bool matchesReference(const PolarResult& polar, const PolarResult& reference) {
+    for (size_t i = 0; i < reference.alpha.size(); ++i) {
+        // Look for the same alpha in the polar (it may be missing if convergence failed)
+        size_t j = 0;
+        while (j < polar.alpha.size() && std::fabs(polar.alpha[j] - reference.alpha[i]) > 1.0e-6) {
+            j++;
+        }
+        if (j == polar.alpha.size()) {
+            return false;
+        }
+
+        if (std::fabs(polar.cL[j] - reference.cL[i]) > panelTolerance * std::fabs(reference.cL[i]) ||
+            std::fabs(polar.cD[j] - reference.cD[i]) > panelTolerance * std::fabs(reference.cD[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Run the panel convergence study of the given airfoil
+int runPanelConvergenceStudy(const std::string& airfoilFile) {
+    // Probe alphas are evenly spread over the configured alpha range
+    double probeStep = probeAlphas > 1 ? (alphaEnd - alphaStart) / (probeAlphas - 1) : alphaEnd - alphaStart + 1.0;
+
+    // Step 1: Simulate the probe alphas with every candidate panel count, in parallel
+    std::vector<SimulationJob> jobs;
+    for (int nodes : panelCandidates) {
+        SimulationJob job = makeSimulationJob(airfoilFile, "panels_" + std::to_string(nodes) + "_polar.dat");
+        job.lastAlpha = alphaStart + probeStep * (probeAlphas - 1);
+        job.alphaStep = probeStep;
+        job.nodes = nodes;
+        jobs.push_back(job);
+    }
+
+    std::cout << "\nRunning panel convergence study (" << panelCandidates.size() << " panel counts, "
+              << probeAlphas << " probe alphas)..." << std::endl;
+    std::vector<PolarResult> results = runSimulationBatch(jobs, simulationWorkers);
+
+    // Step 2: Use the finest discretization as reference (if it failed, keep the default panel nodes)
+    const PolarResult& reference = results.back();
+    if (reference.alpha.size() < static_cast<size_t>(probeAlphas)) {
+        std::cerr << "\nWarning: Panel convergence study failed, using " << panelNodes << " panel nodes." << std::endl;
+        return panelNodes;
+    }
+
+    // Step 3: Find the smallest count from which every finer count matches the reference
+    size_t chosen = results.size() - 1;
+    while (chosen > 0 && matchesReference(results[chosen - 1], reference)) {
+        chosen--;
+    }
+
+    int nodes = panelCandidates[chosen];
+    panelNodesByAirfoil[panelNodesKey(airfoilFile, reynoldsNumber)] = nodes;
+    std::cout << "Panel nodes chosen for '" << airfoilFile << "': " << nodes << std::endl;
+
+    return nodes;
+}
+
+// Check whether a panel node count has already been chosen for the given airfoil
+bool hasPanelNodes(const std::string& airfoilFile) {
+    return panelNodesByAirfoil.count(panelNodesKey(airfoilFile, reynoldsNumber)) > 0;
+}
+
+// Get the panel node count to use for the given airfoil
+int getPanelNodes(const std::string& airfoilFile) {
+    auto found = panelNodesByAirfoil.find(panelNodesKey(airfoilFile, reynoldsNumber));
+    return found != panelNodesByAirfoil.end() ? found->second : panelNodes;
+}
+
+// Save the chosen panel node counts, one airfoil per line ("<panel nodes> <contents hash> <Reynolds number>")
+void savePanelNodes(const std::string& filename) {
+    std::ofstream outfile(filename);
+    for (const auto& entry : panelNodesByAirfoil) {
+        outfile << entry.second << " " << entry.first << "\n";
+    }
+}
+
+// Read the count stored for a single airfoil in a file written by savePanelNodes()
+int readPanelNodes(const std::string& filename, const std::string& airfoilFile, double reynolds, int defaultNodes) {
+    std::string key = panelNodesKey(airfoilFile, reynolds);
+    std::ifstream infile(filename);
+    std::string line;
+
+    while (std::getline(infile, line)) {
+        std::istringstream ss(line);
+        int nodes;
+        std::string hash, reynoldsText;
+        if (ss >> nodes >> hash >> reynoldsText && hash + " " + reynoldsText == key) {
+            return nodes;
+        }
+    }
+    return defaultNodes;
+}
+
+// Load the panel node counts saved by savePanelNodes() (missing file means no counts chosen yet)
+void loadPanelNodes(const std::string& filename) {
+    panelNodesByAirfoil.clear();
+    std::ifstream infile(filename);
+    std::string line;
+
+    while (std::getline(infile, line)) {
+        std::istringstream ss(line);
+        int nodes;
+        std::string hash, reynolds;
+        if (ss >> nodes >> hash >> reynolds && hash.size() == 16) {       // Lines keyed by file name (older versions) are ignored
+            panelNodesByAirfoil[hash + " " + reynolds] = nodes;
+        }
+    }
+}
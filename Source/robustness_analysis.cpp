@@ -0,0 +1,175 @@
+/*
+    This file implements a Monte Carlo analysis of the sensitivity of an airfoil to manufacturing tolerances.
+    Real wing sections are hot-wire cut and sanded, so their shape never matches exactly the coordinates file:
+    an optimal configuration is useful only if small surface errors do not change it significantly.
+
+    Starting from the loaded coordinates, a number of perturbed geometries is generated by displacing each
+    point along the surface normal. The deviation is a random combination of smooth sine modes along the
+    contour (zero at the trailing edge, so that it stays closed), scaled to the configured RMS amplitude.
+
+    All the perturbed geometries are simulated in parallel xfoil processes, and for each one the optimal
+    configuration is found with the same criterion used by findOptimalConfig(). The spread of the optimal
+    alpha, CL and L/D (and of the maximum CL and L/D) is displayed and saved in 'robustness_recap.txt'.
+*/
+
+#include "../Header/robustness_analysis.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/find_optimal_config.h"
+#include "../Header/panel_convergence.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Generate a perturbed airfoil.
+// The normal deviation is d(s) = sum(a_m * sin(m * pi * s)), where s is the normalized arc length along the contour
+// (from trailing edge to trailing edge) and a_m are random coefficients giving on average the requested RMS amplitude
+std::vector<Point> perturbAirfoil(const std::vector<Point>& points, double amplitude, int modes, std::mt19937& generator) {
+    std::vector<Point> perturbed(points);
+    if (points.size() < 3 || modes < 1) {
+        return perturbed;
+    }
+
+    // Each sine mode has an RMS value of 1/sqrt(2), so the coefficients have variance 2 * amplitude^2 / modes
+    std::normal_distribution<double> coefficient(0.0, amplitude * std::sqrt(2.0 / modes));
+    std::vector<double> a(modes);
+    for (auto& value : a) {
+        value = coefficient(generator);
+    }
+
+    // Compute the normalized arc length of each point
+    std::vector<double> s(points.size(), 0.0);
+    for (size_t i = 1; i < points.size(); ++i) {
+        s[i] = s[i - 1] + std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+    }
+    if (s.back() <= 0.0) {
+        return perturbed;
+    }
+
+    const double pi = std::acos(-1.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        // Tangent by central differences (one-sided at the trailing edge), normal obtained by rotating it
+        const Point& prev = points[i > 0 ? i - 1 : i];
+        const Point& next = points[i + 1 < points.size() ? i + 1 : i];
+        double tx = next.x - prev.x;
+        double ty = next.y - prev.y;
+        double length = std::hypot(tx, ty);
+        if (length <= 0.0) {
+            continue;
+        }
+
+        // Smooth deviation at this point of the contour
+        double deviation = 0.0;
+        for (int m = 0; m < modes; ++m) {
+            deviation += a[m] * std::sin((m + 1) * pi * s[i] / s.back());
+        }
+
+        perturbed[i].x += -ty / length * deviation;
+        perturbed[i].y += tx / length * deviation;
+    }
+
+    return perturbed;
+}
+
+// Compute mean, standard deviation, minimum and maximum of the given values
+SampleStatistics computeStatistics(const std::vector<double>& values) {
+    SampleStatistics stats = {0.0, 0.0, 0.0, 0.0};
+    if (values.empty()) {
+        return stats;
+    }
+
+    stats.min = *std::min_element(values.begin(), values.end());
+    stats.max = *std::max_element(values.begin(), values.end());
+    for (double value : values) {
+        stats.mean += value / values.size();
+    }
+    for (double value : values) {
+        stats.stdDev += (value - stats.mean) * (value - stats.mean);
+    }
+    stats.stdDev = values.size() > 1 ? std::sqrt(stats.stdDev / (values.size() - 1)) : 0.0;
+
+    return stats;
+}
+
+// Helper function to write a row of the recap table, both to the console and to the recap file
+void writeStatisticsRow(std::ostream& out, const std::string& label, const SampleStatistics& stats) {
+    out << "  " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(4)
+        << std::setw(12) << stats.mean << std::setw(12) << stats.stdDev
+        << std::setw(12) << stats.min << std::setw(12) << stats.max << "\n";
+}
+
+// Run the manufacturing robustness analysis of the given airfoil
+void runRobustnessAnalysis(const std::string& airfoilFile) {
+    std::string firstLine;
+    std::vector<Point> points = readCoordinatesFromFile(airfoilFile, firstLine);
+
+    // The tolerance is given in meters: convert it to the units of the coordinates file using the chord
+    auto minMaxX = std::minmax_element(points.begin(), points.end());
+    double amplitude = surfaceTolerance / chord * (minMaxX.second->x - minMaxX.first->x);
+
+    // Step 1: Generate the perturbed geometries, saving them in the Output folder so that xfoil can load them
+    std::mt19937 generator(robustnessSeed);
+    std::vector<SimulationJob> jobs;
+    for (int i = 0; i < robustnessSamples; ++i) {
+        std::string geometryFile = "Output/robustness_" + std::to_string(i) + ".dat";
+        saveToFile(geometryFile, firstLine, perturbAirfoil(points, amplitude, perturbationModes, generator));
+        jobs.push_back(makeSimulationJob(geometryFile, "robustness_" + std::to_string(i) + "_polar.dat"));
+        jobs.back().nodes = getPanelNodes(airfoilFile);     // Use the discretization chosen for the original airfoil
+    }
+
+    // Step 2: Simulate all the perturbed geometries in parallel
+    std::cout << "\nSimulating " << robustnessSamples << " perturbed geometries (" << surfaceTolerance * 1000.0
+              << " mm RMS) on " << simulationWorkers << " parallel xfoil processes..." << std::endl;
+    std::vector<PolarResult> results = runSimulationBatch(jobs, simulationWorkers);
+
+    for (const auto& job : jobs) {
+        std::remove(job.airfoilFile.c_str());      // Perturbed geometries are not needed anymore
+    }
+
+    // Step 3: Find the optimal configuration of each perturbed geometry
+    std::vector<double> alphaValues, cLValues, efficiencyValues, cLMaxValues, efficiencyMaxValues;
+    for (const auto& polar : results) {
+        size_t best = findOptimalIndex(polar.cL, polar.cD, polar.efficiency);
+        if (best == polar.cL.size()) {
+            continue;       // Convergence failed for every alpha value
+        }
+
+        alphaValues.push_back(polar.alpha[best]);
+        cLValues.push_back(polar.cL[best]);
+        efficiencyValues.push_back(polar.efficiency[best]);
+        cLMaxValues.push_back(*std::max_element(polar.cL.begin(), polar.cL.end()));
+        efficiencyMaxValues.push_back(*std::max_element(polar.efficiency.begin(), polar.efficiency.end()));
+    }
+
+    if (alphaValues.empty()) {
+        std::cerr << "\nERROR: Convergence failed for every perturbed geometry." << std::endl;
+        return;
+    }
+
+    // Step 4: Display the spread of the results and save it in the recap file
+    std::ofstream recapFile("Output/robustness_recap.txt");
+    if (!recapFile) {
+        std::cerr << "ERROR: Could not open 'robustness_recap.txt'" << std::endl;
+    }
+
+    for (std::ostream* out : {static_cast<std::ostream*>(&std::cout), static_cast<std::ostream*>(&recapFile)}) {
+        *out << "\n--- ROBUSTNESS ANALYSIS ---\n\n";
+        *out << "Airfoil model: " << firstLine << "\n";
+        *out << "Surface tolerance: " << surfaceTolerance * 1000.0 << " mm RMS, " << perturbationModes << " modes\n";
+        *out << "Converged geometries: " << alphaValues.size() << " / " << robustnessSamples << "\n\n";
+        *out << "  " << std::left << std::setw(14) << "" << std::right << std::setw(12) << "Mean"
+             << std::setw(12) << "Std Dev" << std::setw(12) << "Min" << std::setw(12) << "Max" << "\n";
+        writeStatisticsRow(*out, "Alpha optimal", computeStatistics(alphaValues));
+        writeStatisticsRow(*out, "CL optimal", computeStatistics(cLValues));
+        writeStatisticsRow(*out, "L/D optimal", computeStatistics(efficiencyValues));
+        writeStatisticsRow(*out, "CL max", computeStatistics(cLMaxValues));
+        writeStatisticsRow(*out, "L/D max", computeStatistics(efficiencyMaxValues));
+        *out << std::defaultfloat << std::flush;
+    }
+
+    std::cout << "\nResults stored in 'robustness_recap.txt'." << std::endl;
+}
@@ -0,0 +1,279 @@
+/*
+    This file implements the run journal, a write-ahead log of the simulations completed by a long campaign
+    (e.g. a family sweep or the update of a whole library), so that a campaign interrupted by a crash, a power
+    loss or the user can be restarted without simulating again what was already done.
+
+    Every simulated (airfoil, Reynolds number, alpha) unit is appended to the journal of the campaign as soon as
+    its batch job is completed, with its result (or the information that it did not converge). Units are
+    identified by a hash of the simulation inputs (geometry, panel nodes, iteration limit, Reynolds number), so
+    a unit is reused only if it would be simulated in exactly the same way. When the same campaign is started
+    again, the journal is replayed and batches only simulate the missing units (see batch_simulation.cpp).
+
+    Each record is a text line ending with a checksum:
+      <key> <alpha [millidegrees]> <converged> <CL> <CD> <checksum>
+    The units of a job are appended with a single write, so a crash can only leave the last line incomplete:
+    lines without a valid checksum are ignored, and an incomplete last line is removed before appending again.
+    Written records survive a crash of the program as soon as they are appended; syncing them to disk (needed
+    to survive a power loss) is slow, so it is done once every few hundred records or seconds.
+*/
+
+#include "../Header/run_journal.h"
+#include "../Header/config_settings.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// State of the open journal
+std::mutex journalLock;
+std::string journalFile;                                        // Path of the journal (empty if no journal is open)
+std::string journalHeader;                                      // First line of the journal, describing the campaign
+int journalDescriptor = -1;                                     // File descriptor used to append records
+std::map<std::pair<uint64_t, int32_t>, JournalUnit> journal;    // Recorded units, by key and alpha
+size_t unsyncedRecords = 0;                                     // Records appended since the last sync
+std::chrono::steady_clock::time_point lastSync;                 // Time of the last sync
+
+// Helper function to compute a 64-bit FNV-1a hash
+uint64_t hashText(const std::string& text) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Helper function to compute the checksum of a record (32-bit FNV-1a)
+uint32_t recordChecksum(const std::string& text) {
+    uint32_t hash = 2166136261U;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 16777619U;
+    }
+    return hash;
+}
+
+// Helper functions to append data to the journal and to sync it to disk
+bool appendToJournal(const std::string& data) {
+#ifdef _WIN32
+    return _write(journalDescriptor, data.data(), static_cast<unsigned int>(data.size())) == static_cast<int>(data.size());
+#else
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = write(journalDescriptor, data.data() + written, data.size() - written);
+        if (count <= 0) {
+            return false;
+        }
+        written += count;
+    }
+    return true;
+#endif
+}
+
+void syncJournal() {
+#ifdef _WIN32
+    _commit(journalDescriptor);
+#else
+    fsync(journalDescriptor);
+#endif
+    unsyncedRecords = 0;
+    lastSync = std::chrono::steady_clock::now();
+}
+
+// Helper function to open the journal file for appending, optionally removing its contents
+bool openJournalDescriptor(bool truncate) {
+#ifdef _WIN32
+    journalDescriptor = _open(journalFile.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0),
+                              _S_IREAD | _S_IWRITE);
+#else
+    journalDescriptor = open(journalFile.c_str(), O_WRONLY | O_APPEND | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+#endif
+    return journalDescriptor >= 0;
+}
+
+void closeJournalDescriptor() {
+#ifdef _WIN32
+    _close(journalDescriptor);
+#else
+    close(journalDescriptor);
+#endif
+    journalDescriptor = -1;
+}
+
+// Helper function to read a record (false if it is incomplete or damaged)
+bool parseRecord(const std::string& line, uint64_t& key, int32_t& alphaMilli, JournalUnit& unit) {
+    size_t separator = line.rfind(' ');
+    if (separator == std::string::npos) {
+        return false;
+    }
+
+    std::istringstream fields(line.substr(0, separator));
+    std::string checksum = line.substr(separator + 1);
+    int converged;
+    if (!(fields >> std::hex >> key >> std::dec >> alphaMilli >> converged >> unit.cL >> unit.cD)) {
+        return false;
+    }
+
+    char expected[16];
+    snprintf(expected, sizeof(expected), "%08x", recordChecksum(line.substr(0, separator)));
+    unit.alpha = alphaMilli / 1000.0;
+    unit.converged = (converged != 0);
+    return checksum == expected;
+}
+
+// Open the journal of a campaign, replaying the units recorded by previous runs
+bool openRunJournal(const std::string& campaign) {
+    std::lock_guard<std::mutex> guard(journalLock);
+    if (journalDescriptor >= 0) {
+        closeJournalDescriptor();
+    }
+    journal.clear();
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hashText(campaign)));
+    journalFile = "Output/journal_" + std::string(name) + ".log";
+    journalHeader = "# " + campaign + "\n";
+
+    // Step 1: Replay the records of previous runs, keeping the length of the complete lines
+    std::ifstream file(journalFile, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    size_t complete = 0, damaged = 0;
+    for (size_t end; (end = contents.find('\n', complete)) != std::string::npos; complete = end + 1) {
+        std::string line = contents.substr(complete, end - complete);
+        uint64_t key;
+        int32_t alphaMilli;
+        JournalUnit unit;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (parseRecord(line, key, alphaMilli, unit)) {
+            journal[{key, alphaMilli}] = unit;
+        }
+        else {
+            damaged++;
+        }
+    }
+
+    // Step 2: Remove the incomplete last line (if the previous run crashed while appending it), then open for appending
+    std::error_code error;
+    if (complete < contents.size()) {
+        damaged++;
+        std::filesystem::resize_file(journalFile, complete, error);
+    }
+    bool created = contents.empty() || complete == 0;
+    if (!openJournalDescriptor(created)) {
+        std::cerr << "\nWarning: Could not open the run journal '" << journalFile << "', the campaign cannot be resumed." << std::endl;
+        journalFile.clear();
+        return false;
+    }
+    if (created) {
+        appendToJournal(journalHeader);
+    }
+    syncJournal();
+
+    if (!journal.empty()) {
+        std::cout << "\nResuming campaign: " << journal.size() << " simulated alpha values replayed from '" << journalFile << "'." << std::endl;
+    }
+    if (damaged > 0) {
+        std::cerr << "Warning: " << damaged << " damaged journal record(s) ignored." << std::endl;
+    }
+    return true;
+}
+
+// Close the journal, removing it if the campaign is completed
+void closeRunJournal(bool completed) {
+    std::lock_guard<std::mutex> guard(journalLock);
+    if (journalDescriptor < 0) {
+        return;
+    }
+
+    syncJournal();
+    closeJournalDescriptor();
+    if (completed) {
+        std::remove(journalFile.c_str());
+    }
+    journalFile.clear();
+    journal.clear();
+}
+
+// Remove the units recorded so far
+void clearRunJournal() {
+    std::lock_guard<std::mutex> guard(journalLock);
+    if (journalDescriptor < 0) {
+        return;
+    }
+
+    closeJournalDescriptor();
+    journal.clear();
+    if (openJournalDescriptor(true)) {
+        appendToJournal(journalHeader);
+        syncJournal();
+    }
+}
+
+// Check whether a journal is open
+bool runJournalOpen() {
+    std::lock_guard<std::mutex> guard(journalLock);
+    return journalDescriptor >= 0;
+}
+
+// Compute the key of the simulations sharing the given inputs
+uint64_t journalKey(const std::string& inputs) {
+    return hashText(inputs);
+}
+
+// Find a recorded unit. Alpha is compared in millidegrees, the resolution of the polar files written by xfoil
+bool findJournalUnit(uint64_t key, double alpha, JournalUnit& unit) {
+    std::lock_guard<std::mutex> guard(journalLock);
+    auto found = journal.find({key, static_cast<int32_t>(std::lround(alpha * 1000.0))});
+    if (found == journal.end()) {
+        return false;
+    }
+    unit = found->second;
+    return true;
+}
+
+// Record the given units with a single append, syncing the journal when enough records (or time) have accumulated
+void recordJournalUnits(uint64_t key, const std::vector<JournalUnit>& units) {
+    std::lock_guard<std::mutex> guard(journalLock);
+    if (journalDescriptor < 0 || units.empty()) {
+        return;
+    }
+
+    std::string records;
+    for (const auto& unit : units) {
+        int32_t alphaMilli = static_cast<int32_t>(std::lround(unit.alpha * 1000.0));
+        char text[128], line[160];
+        snprintf(text, sizeof(text), "%016llx %d %d %.10g %.10g", static_cast<unsigned long long>(key), alphaMilli,
+                 unit.converged ? 1 : 0, unit.cL, unit.cD);
+        snprintf(line, sizeof(line), "%s %08x\n", text, recordChecksum(text));
+        records += line;
+        journal[{key, alphaMilli}] = unit;
+    }
+
+    if (!appendToJournal(records)) {
+        std::cerr << "\nWarning: Could not write to the run journal '" << journalFile << "'." << std::endl;
+        return;
+    }
+
+    unsyncedRecords += units.size();
+    if (unsyncedRecords >= journalSyncRecords ||
+        std::chrono::steady_clock::now() - lastSync >= std::chrono::seconds(journalSyncInterval)) {
+        syncJournal();
+    }
+}
@@ -0,0 +1,264 @@
+/*
+    This file implements a finite-difference sensitivity analysis of the simulation results.
+    Besides the optimal configuration, a designer needs to know how fast CL, CD and L/D change with
+    the angle of attack, the Reynolds number and small changes of the shape, e.g. for stability
+    derivatives or to decide which part of the surface needs the tightest tolerance.
+
+    Each variable is perturbed by -2h, -h, +h and +2h around the current configuration:
+      - alpha: the whole sweep is shifted, so each perturbed polar gives the value at every alpha at once
+      - Reynolds number: the same sweep is run at the perturbed Reynolds number
+      - shape modes: a smooth bump on the upper or lower surface is added to the geometry
+    All the perturbed cases (and the baseline) share the same panel nodes, iteration limit and alpha sweep,
+    and are run together as a single batch on parallel xfoil processes, so the whole Jacobian takes about
+    as long as a single sweep when enough processes are available.
+
+    Steps are chosen from the resolution of the polar file: a central difference has a truncation error
+    proportional to h^2 and a rounding error proportional to noise/h, which are balanced by h ~ noise^(1/3).
+    The derivative is the Richardson extrapolation of the central differences with steps h and 2h,
+    and their difference gives an estimate of the remaining truncation error.
+*/
+
+#include "../Header/sensitivity_analysis.h"
+#include "../Header/batch_simulation.h"
+#include "../Header/config_settings.h"
+#include "../Header/find_optimal_config.h"
+#include "../Header/panel_convergence.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Offsets of the perturbed cases, in units of the step of each variable
+const std::vector<int> stepOffsets = {-2, -1, 1, 2};
+
+// Characteristic scales of the variables (change giving an O(1) relative change of the coefficients)
+const double alphaScale = 5.0;          // Angle of attack  [deg]
+const double shapeScale = 0.02;         // Bump amplitude   [fraction of chord]
+
+// Apply a shape mode to an airfoil.
+// Mode 2*p is a bump on the upper surface and mode 2*p+1 a bump on the lower surface, both peaking at
+// x/c = shapeModePeaks[p]. Bumps are Hicks-Henne functions b(x) = sin^3(pi * x^m), with m = ln(0.5) / ln(peak),
+// which are smooth and vanish at leading and trailing edge. A positive amplitude makes the airfoil thicker
+std::vector<Point> applyShapeMode(const std::vector<Point>& points, size_t mode, double amplitude) {
+    std::vector<Point> perturbed(points);
+    if (points.size() < 3 || mode >= 2 * shapeModePeaks.size()) {
+        return perturbed;
+    }
+
+    // Split the contour at the leading edge (minimum x) and find which side is the upper surface
+    auto minMaxX = std::minmax_element(points.begin(), points.end());
+    size_t leadingEdge = minMaxX.first - points.begin();
+    double xMin = minMaxX.first->x;
+    double length = minMaxX.second->x - xMin;
+    if (length <= 0.0) {
+        return perturbed;
+    }
+
+    double firstSideY = 0.0, secondSideY = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        (i < leadingEdge ? firstSideY : secondSideY) += points[i].y / (i < leadingEdge ? leadingEdge : points.size() - leadingEdge);
+    }
+    bool firstSideUpper = firstSideY > secondSideY;
+    bool upperMode = (mode % 2 == 0);
+
+    const double pi = std::acos(-1.0);
+    double exponent = std::log(0.5) / std::log(shapeModePeaks[mode / 2]);
+    for (size_t i = 0; i < points.size(); ++i) {
+        bool upperPoint = (i < leadingEdge) == firstSideUpper;
+        double x = (points[i].x - xMin) / length;
+        if (upperPoint != upperMode || i == leadingEdge || x <= 0.0 || x >= 1.0) {
+            continue;
+        }
+
+        double bump = std::pow(std::sin(pi * std::pow(x, exponent)), 3);
+        perturbed[i].y += (upperMode ? 1.0 : -1.0) * amplitude * length * bump;
+    }
+
+    return perturbed;
+}
+
+// Helper function to find the coefficients at the given alpha in a polar (false if that alpha did not converge)
+bool lookupPolar(const PolarResult& polar, double alphaValue, double values[3]) {
+    for (size_t i = 0; i < polar.alpha.size(); ++i) {
+        if (std::fabs(polar.alpha[i] - alphaValue) < 1e-3) {     // Alpha is written by xfoil with 3 decimals
+            values[0] = polar.cL[i];
+            values[1] = polar.cD[i];
+            values[2] = polar.efficiency[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Compute the Jacobian of the polar of an airfoil
+SensitivityResult computeSensitivities(const std::string& airfoilFile) {
+    SensitivityResult result;
+
+    std::string firstLine;
+    std::vector<Point> points = readCoordinatesFromFile(airfoilFile, firstLine);
+
+    // Step 1: Choose the steps. The alpha step is rounded to 0.01 deg so that shifted sweeps
+    // give exactly the baseline alpha values once written with 3 decimals in the polar file
+    double stepFactor = std::cbrt(solverNoise);
+    std::vector<std::string> names = {"alpha [deg]", "Re"};
+    std::vector<double> steps = {std::max(0.01, std::round(stepFactor * alphaScale * 100.0) / 100.0),
+                                 stepFactor * reynoldsNumber};
+    for (size_t p = 0; p < shapeModePeaks.size(); ++p) {
+        for (const char* surface : {"Upper", "Lower"}) {
+            std::ostringstream name;
+            name << surface << " bump x/c=" << shapeModePeaks[p];
+            names.push_back(name.str());
+            steps.push_back(stepFactor * shapeScale);
+        }
+    }
+
+    // Step 2: Build the baseline case and the perturbed cases of every variable, sharing the same discretization
+    int nodes = getPanelNodes(airfoilFile);
+    std::vector<SimulationJob> jobs;
+    jobs.push_back(makeSimulationJob(airfoilFile, "sensitivity_baseline_polar.dat"));
+    jobs.back().nodes = nodes;
+
+    for (size_t v = 0; v < names.size(); ++v) {
+        for (int offset : stepOffsets) {
+            std::string caseName = "sensitivity_" + std::to_string(v) + "_" + std::to_string(offset + 2);
+            SimulationJob job = makeSimulationJob(airfoilFile, caseName + "_polar.dat");
+            job.nodes = nodes;
+
+            if (v == 0) {
+                job.firstAlpha += offset * steps[v];
+                job.lastAlpha += offset * steps[v];
+            }
+            else if (v == 1) {
+                job.reynolds += offset * steps[v];
+            }
+            else {
+                job.airfoilFile = "Output/" + caseName + ".dat";
+                saveToFile(job.airfoilFile, firstLine, applyShapeMode(points, v - 2, offset * steps[v]));
+            }
+            jobs.push_back(job);
+        }
+    }
+
+    // Step 3: Run all the cases as a single parallel batch
+    std::cout << "\nSimulating " << jobs.size() << " perturbed cases on " << simulationWorkers
+              << " parallel xfoil processes..." << std::endl;
+    std::vector<PolarResult> polars = runSimulationBatch(jobs, simulationWorkers);
+
+    for (const auto& job : jobs) {
+        if (job.airfoilFile.compare(0, 7, "Output/") == 0) {
+            std::remove(job.airfoilFile.c_str());      // Perturbed geometries are not needed anymore
+        }
+    }
+
+    // Step 4: Differentiate at every alpha of the baseline sweep
+    result.alpha = polars[0].alpha;
+    for (size_t v = 0; v < names.size(); ++v) {
+        SensitivityRow row = {names[v], steps[v], {}, {}, {}};
+        double h = steps[v];
+
+        for (size_t i = 0; i < result.alpha.size(); ++i) {
+            double baseline[3] = {polars[0].cL[i], polars[0].cD[i], polars[0].efficiency[i]};
+
+            // Coefficients of the four perturbed cases, ordered as stepOffsets
+            double values[4][3];
+            bool available = true;
+            for (size_t k = 0; k < stepOffsets.size(); ++k) {
+                double alphaValue = result.alpha[i] + (v == 0 ? stepOffsets[k] * h : 0.0);
+                available = available && lookupPolar(polars[1 + v * stepOffsets.size() + k], alphaValue, values[k]);
+            }
+
+            // Resolution of each coefficient in the polar file: CL has 4 decimals, CD has 5, L/D inherits both
+            double noise[3] = {solverNoise, solverNoise / 10.0,
+                               std::fabs(baseline[2]) * (solverNoise / std::max(std::fabs(baseline[0]), solverNoise)
+                                                         + solverNoise / 10.0 / std::max(baseline[1], solverNoise))};
+
+            std::vector<Sensitivity>* outputs[3] = {&row.dCL, &row.dCD, &row.dEfficiency};
+            for (int c = 0; c < 3; ++c) {
+                if (!available) {
+                    outputs[c]->push_back({0.0, 0.0, false});
+                    continue;
+                }
+
+                double centralH = (values[2][c] - values[1][c]) / (2.0 * h);
+                double central2H = (values[3][c] - values[0][c]) / (4.0 * h);
+                double value = (4.0 * centralH - central2H) / 3.0;
+                double error = std::fabs(centralH - central2H) / 3.0 + noise[c] / h;
+                outputs[c]->push_back({value, error, true});
+            }
+        }
+
+        result.rows.push_back(row);
+    }
+
+    return result;
+}
+
+// Helper function to write a derivative with its error estimate
+std::string formatSensitivity(const Sensitivity& sensitivity) {
+    if (!sensitivity.valid) {
+        return "-";
+    }
+    std::ostringstream text;
+    text << std::scientific << std::setprecision(3) << sensitivity.value << " +/- " << std::setprecision(1) << sensitivity.error;
+    return text.str();
+}
+
+// Run the sensitivity analysis of the given airfoil
+void runSensitivityAnalysis(const std::string& airfoilFile) {
+    SensitivityResult result = computeSensitivities(airfoilFile);
+    if (result.alpha.empty()) {
+        std::cerr << "\nERROR: Convergence failed for every alpha value of the baseline case." << std::endl;
+        return;
+    }
+
+    // Display the Jacobian at the optimal alpha of the baseline case
+    std::string firstLine;
+    readCoordinatesFromFile(airfoilFile, firstLine);
+
+    size_t best = 0;
+    double bestAlpha = alphaOptimal;
+    for (size_t i = 0; i < result.alpha.size(); ++i) {
+        if (std::fabs(result.alpha[i] - bestAlpha) < std::fabs(result.alpha[best] - bestAlpha)) {
+            best = i;
+        }
+    }
+
+    std::cout << "\n--- SENSITIVITY ANALYSIS ---\n\n";
+    std::cout << "Airfoil model: " << firstLine << "\n";
+    std::cout << "Derivatives at alpha = " << result.alpha[best] << " deg:\n\n";
+    std::cout << "  " << std::left << std::setw(22) << "Variable" << std::setw(26) << "dCL"
+              << std::setw(26) << "dCD" << "dL/D" << "\n";
+    for (const auto& row : result.rows) {
+        std::cout << "  " << std::setw(22) << row.variable << std::setw(26) << formatSensitivity(row.dCL[best])
+                  << std::setw(26) << formatSensitivity(row.dCD[best]) << formatSensitivity(row.dEfficiency[best]) << "\n";
+    }
+    std::cout << std::right << std::flush;
+
+    // Save the derivatives at every alpha in the recap file
+    std::ofstream recapFile("Output/sensitivity_recap.txt");
+    if (!recapFile) {
+        std::cerr << "ERROR: Could not open 'sensitivity_recap.txt'" << std::endl;
+        return;
+    }
+
+    recapFile << "--- SENSITIVITY ANALYSIS ---\n\n";
+    recapFile << "Airfoil model: " << firstLine << "\n";
+    recapFile << "Reynolds number: " << reynoldsNumber << "\n";
+    recapFile << "Shape modes: Hicks-Henne bumps, amplitude as fraction of chord\n";
+    for (const auto& row : result.rows) {
+        recapFile << "\nd/d(" << row.variable << "), step " << row.step << "\n";
+        recapFile << "  " << std::left << std::setw(10) << "Alpha" << std::setw(26) << "dCL"
+                  << std::setw(26) << "dCD" << "dL/D" << "\n";
+        for (size_t i = 0; i < result.alpha.size(); ++i) {
+            recapFile << "  " << std::setw(10) << result.alpha[i] << std::setw(26) << formatSensitivity(row.dCL[i])
+                      << std::setw(26) << formatSensitivity(row.dCD[i]) << formatSensitivity(row.dEfficiency[i]) << "\n";
+        }
+        recapFile << std::right;
+    }
+
+    std::cout << "\nResults stored in 'sensitivity_recap.txt'." << std::endl;
+}
@@ -0,0 +1,444 @@
+/*
+    This file implements an index of airfoil shapes used to reuse polars that have already been computed.
+    Each airfoil is reduced to a normalized shape signature: both surfaces are scaled to unit chord and
+    resampled at a fixed set of cosine-spaced x-stations, so that airfoils with a different number or
+    distribution of coordinates can be compared directly through the RMS distance of their signatures.
+
+    The signatures are organized in a vantage-point tree, which allows exact k-nearest-neighbour queries
+    without scanning the whole library. Newly added shapes are kept in a small pending list that is scanned
+    linearly, and the tree is rebuilt only once this list grows too long, so insertions remain cheap.
+
+    If a new airfoil matches an indexed shape within a tolerance (and the polar was computed at the same
+    Reynolds number, with the same panel nodes, iteration limit and alpha range) the stored polar can be used
+    directly, skipping xfoil entirely. Otherwise the polars
+    of the closest neighbours provide an immediate estimate while the new airfoil is being simulated.
+
+    The index file is append-only: every solved polar is appended with its shape, and loading the file merges
+    the blocks of the same shape (a later polar replaces an earlier one computed with the same inputs).
+*/
+
+#include "../Header/shape_index.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <map>
+#include <cstdio>
+
+// Number of x-stations used to resample each surface of the airfoil
+const int shapeStations = 32;
+
+// Maximum RMS distance between two signatures (in chord units) to consider two airfoils as the same one
+const double duplicateShapeTolerance = 1.0e-4;
+
+// Relative tolerance used to consider two Reynolds numbers as the same one
+const double reynoldsTolerance = 1.0e-6;
+
+// Number of not yet indexed entries that triggers a rebuild of the vantage-point tree
+const size_t maxPendingShapes = 256;
+
+// Global vector to store all the indexed shapes
+std::vector<ShapeEntry> shapeIndex;
+
+// Node of the vantage-point tree: entries closer than 'threshold' to the vantage point are stored
+// in the 'inside' subtree, the remaining ones in the 'outside' subtree (-1 means empty subtree)
+struct VpNode {
+    size_t entry;
+    double threshold;
+    int inside;
+    int outside;
+};
+
+std::vector<VpNode> vpTree;     // Nodes of the vantage-point tree
+int vpRoot = -1;                // Index of the root node
+size_t treeEntries = 0;         // Number of entries (from the start of shapeIndex) covered by the tree
+
+// Helper function to interpolate the y-coordinate of a surface (sorted by x) at the given x-station
+double interpolateSurface(const std::vector<Point>& surface, double x) {
+    // Clamp stations outside the surface range to its end points
+    if (x <= surface.front().x) return surface.front().y;
+    if (x >= surface.back().x) return surface.back().y;
+
+    // Find the first point with x greater than the station and interpolate linearly
+    auto upper = std::upper_bound(surface.begin(), surface.end(), Point{x, 0.0});
+    auto lower = upper - 1;
+    double span = upper->x - lower->x;
+    if (span <= 0.0) {
+        return lower->y;
+    }
+    return lower->y + (upper->y - lower->y) * (x - lower->x) / span;
+}
+
+// Compute the shape signature of an airfoil.
+// The airfoil is split at the leading edge (minimum x), scaled to unit chord and both surfaces are sampled
+// at the same cosine-spaced stations, which are denser near the leading and trailing edges
+std::vector<double> computeShapeSignature(const std::vector<Point>& points) {
+    std::vector<double> signature(2 * shapeStations, 0.0);
+    if (points.size() < 3) {
+        return signature;
+    }
+
+    // Find leading edge (minimum x) and trailing edge (maximum x) to normalize the coordinates
+    auto minMaxX = std::minmax_element(points.begin(), points.end());
+    size_t leadingIndex = static_cast<size_t>(minMaxX.first - points.begin());
+    double xLeading = minMaxX.first->x;
+    double yLeading = minMaxX.first->y;
+    double chordLength = minMaxX.second->x - xLeading;
+    if (chordLength <= 0.0) {
+        return signature;
+    }
+
+    // Split the points into the two surfaces, both including the leading edge
+    std::vector<Point> first(points.begin(), points.begin() + leadingIndex + 1);
+    std::vector<Point> second(points.begin() + leadingIndex, points.end());
+
+    // Normalize both surfaces to unit chord, with the leading edge in the origin
+    double meanFirst = 0.0, meanSecond = 0.0;
+    for (auto& p : first) {
+        p = {(p.x - xLeading) / chordLength, (p.y - yLeading) / chordLength};
+        meanFirst += p.y / first.size();
+    }
+    for (auto& p : second) {
+        p = {(p.x - xLeading) / chordLength, (p.y - yLeading) / chordLength};
+        meanSecond += p.y / second.size();
+    }
+
+    // The upper surface is the one with the highest mean y-coordinate
+    if (meanSecond > meanFirst) {
+        std::swap(first, second);
+    }
+    std::stable_sort(first.begin(), first.end());
+    std::stable_sort(second.begin(), second.end());
+
+    // Resample both surfaces at the cosine-spaced stations
+    const double pi = std::acos(-1.0);
+    for (int k = 0; k < shapeStations; ++k) {
+        double x = 0.5 * (1.0 - std::cos(pi * k / (shapeStations - 1)));
+        signature[k] = interpolateSurface(first, x);
+        signature[shapeStations + k] = interpolateSurface(second, x);
+    }
+
+    return signature;
+}
+
+// Compute the RMS distance between two signatures (a true metric, as required by the vantage-point tree)
+double shapeDistance(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        double d = a[i] - b[i];
+        sum += d * d;
+    }
+    return std::sqrt(sum / std::max<size_t>(a.size(), 1));
+}
+
+// Helper function to recursively build the subtree containing items[lo, hi)
+int buildVpSubtree(std::vector<size_t>& items, size_t lo, size_t hi) {
+    if (lo >= hi) {
+        return -1;
+    }
+
+    // Use the middle item as vantage point (the items order does not depend on the shapes)
+    std::swap(items[lo], items[lo + (hi - lo) / 2]);
+    int nodeIndex = static_cast<int>(vpTree.size());
+    vpTree.push_back({items[lo], 0.0, -1, -1});
+
+    if (hi - lo > 1) {
+        // Split the remaining items at the median distance from the vantage point
+        const std::vector<double>& vantage = shapeIndex[items[lo]].signature;
+        size_t mid = lo + 1 + (hi - lo - 1) / 2;
+        std::nth_element(items.begin() + lo + 1, items.begin() + mid, items.begin() + hi,
+            [&vantage](size_t a, size_t b) {
+                return shapeDistance(vantage, shapeIndex[a].signature) < shapeDistance(vantage, shapeIndex[b].signature);
+            });
+        vpTree[nodeIndex].threshold = shapeDistance(vantage, shapeIndex[items[mid]].signature);
+
+        // Build the subtrees (the node is accessed by index since vpTree may be reallocated)
+        int inside = buildVpSubtree(items, lo + 1, mid);
+        int outside = buildVpSubtree(items, mid, hi);
+        vpTree[nodeIndex].inside = inside;
+        vpTree[nodeIndex].outside = outside;
+    }
+
+    return nodeIndex;
+}
+
+// Helper function to rebuild the vantage-point tree over all the indexed shapes
+void rebuildShapeTree() {
+    std::vector<size_t> items(shapeIndex.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = i;
+    }
+
+    vpTree.clear();
+    vpTree.reserve(items.size());
+    vpRoot = buildVpSubtree(items, 0, items.size());
+    treeEntries = shapeIndex.size();
+}
+
+// Max-heap of the best matches found so far (the worst match is on top)
+typedef std::priority_queue<std::pair<double, size_t>> MatchHeap;
+
+// Helper function to add a candidate to the heap of best matches, keeping only the best k
+void offerMatch(MatchHeap& best, size_t k, double distance, size_t entry) {
+    if (best.size() < k) {
+        best.push({distance, entry});
+    }
+    else if (distance < best.top().first) {
+        best.pop();
+        best.push({distance, entry});
+    }
+}
+
+// Helper function to search the subtree rooted in 'node', skipping subtrees that cannot contain better matches
+void searchVpSubtree(int node, const std::vector<double>& signature, size_t k, MatchHeap& best) {
+    if (node < 0) {
+        return;
+    }
+
+    const VpNode& current = vpTree[node];
+    double distance = shapeDistance(signature, shapeIndex[current.entry].signature);
+    offerMatch(best, k, distance, current.entry);
+
+    // Radius of the search: distance of the worst match kept (infinite until k matches are found)
+    auto radius = [&best, k]() {
+        return best.size() < k ? std::numeric_limits<double>::infinity() : best.top().first;
+    };
+
+    // Visit first the subtree on the same side of the query, then the other one only if needed
+    if (distance < current.threshold) {
+        if (distance - radius() <= current.threshold) searchVpSubtree(current.inside, signature, k, best);
+        if (distance + radius() >= current.threshold) searchVpSubtree(current.outside, signature, k, best);
+    }
+    else {
+        if (distance + radius() >= current.threshold) searchVpSubtree(current.outside, signature, k, best);
+        if (distance - radius() <= current.threshold) searchVpSubtree(current.inside, signature, k, best);
+    }
+}
+
+// Find the k indexed shapes closest to the given signature
+std::vector<ShapeMatch> findNearestShapes(const std::vector<double>& signature, size_t k) {
+    std::vector<ShapeMatch> matches;
+    if (k == 0 || shapeIndex.empty()) {
+        return matches;
+    }
+
+    // Search the tree first, then scan the shapes added after the last rebuild
+    MatchHeap best;
+    searchVpSubtree(vpRoot, signature, k, best);
+    for (size_t i = treeEntries; i < shapeIndex.size(); ++i) {
+        offerMatch(best, k, shapeDistance(signature, shapeIndex[i].signature), i);
+    }
+
+    // Extract the matches from the heap, sorting them by increasing distance
+    while (!best.empty()) {
+        matches.push_back({best.top().second, best.top().first});
+        best.pop();
+    }
+    std::reverse(matches.begin(), matches.end());
+
+    return matches;
+}
+
+// Helper function to check whether two Reynolds numbers can be considered the same
+bool sameReynolds(double a, double b) {
+    return std::fabs(a - b) <= reynoldsTolerance * std::max(std::fabs(a), std::fabs(b));
+}
+
+// Describe the solver inputs of a polar other than shape and Reynolds number
+std::string solverSettingsKey(int nodes, int iterations, double firstAlpha, double lastAlpha, double alphaStep) {
+    char key[96];
+    snprintf(key, sizeof(key), "%d %d %.6g %.6g %.6g", nodes, iterations, firstAlpha, lastAlpha, alphaStep);
+    return key;
+}
+
+// Add a solved polar to the index. If the shape is already indexed (within the duplicate tolerance) the polar is
+// attached to the existing entry, replacing any polar computed at the same Reynolds number with the same settings
+size_t addShapeToIndex(const std::string& name, const std::vector<double>& signature, const StoredPolar& polar) {
+    std::vector<ShapeMatch> nearest = findNearestShapes(signature, 1);
+
+    if (!nearest.empty() && nearest.front().distance <= duplicateShapeTolerance) {
+        ShapeEntry& entry = shapeIndex[nearest.front().entry];
+        for (auto& stored : entry.polars) {
+            if (sameReynolds(stored.reynolds, polar.reynolds) && stored.settings == polar.settings) {
+                stored = polar;     // Replace the polar computed with the same inputs
+                return nearest.front().entry;
+            }
+        }
+        entry.polars.push_back(polar);
+        return nearest.front().entry;
+    }
+
+    // New shape: append it to the pending list and rebuild the tree if the list grew too long
+    shapeIndex.push_back({name, signature, {polar}});
+    if (shapeIndex.size() - treeEntries > maxPendingShapes) {
+        rebuildShapeTree();
+    }
+
+    return shapeIndex.size() - 1;
+}
+
+// Find a polar computed for the same shape (within the duplicate tolerance) at the same Reynolds number and settings.
+// Polars stored without settings (by older versions of the index) are never reused, only used for estimates
+const StoredPolar* findDuplicatePolar(const std::vector<double>& signature, double reynolds, const std::string& settings) {
+    std::vector<ShapeMatch> nearest = findNearestShapes(signature, 1);
+    if (nearest.empty() || nearest.front().distance > duplicateShapeTolerance) {
+        return nullptr;
+    }
+
+    for (const auto& stored : shapeIndex[nearest.front().entry].polars) {
+        if (sameReynolds(stored.reynolds, reynolds) && !settings.empty() && stored.settings == settings) {
+            return &stored;
+        }
+    }
+
+    return nullptr;
+}
+
+// Estimate the polar of a shape by inverse-distance weighting of the polars of its k closest neighbours.
+// Only neighbours solved at the same Reynolds number are used, and each alpha value is averaged separately
+bool estimatePolarFromNeighbours(const std::vector<double>& signature, double reynolds, size_t k, StoredPolar& estimate) {
+    estimate = {reynolds, {}, {}, {}, ""};
+    std::vector<double> weights;
+
+    for (const auto& match : findNearestShapes(signature, k)) {
+        for (const auto& stored : shapeIndex[match.entry].polars) {
+            if (!sameReynolds(stored.reynolds, reynolds)) {
+                continue;
+            }
+
+            double weight = 1.0 / std::max(match.distance, duplicateShapeTolerance);
+            for (size_t i = 0; i < stored.alpha.size(); ++i) {
+                // Find the alpha value in the estimate, adding it if not present yet
+                size_t j = 0;
+                while (j < estimate.alpha.size() && std::fabs(estimate.alpha[j] - stored.alpha[i]) > 1.0e-6) {
+                    j++;
+                }
+                if (j == estimate.alpha.size()) {
+                    estimate.alpha.push_back(stored.alpha[i]);
+                    estimate.cL.push_back(0.0);
+                    estimate.cD.push_back(0.0);
+                    weights.push_back(0.0);
+                }
+                estimate.cL[j] += weight * stored.cL[i];
+                estimate.cD[j] += weight * stored.cD[i];
+                weights[j] += weight;
+            }
+        }
+    }
+
+    // Normalize the weighted sums
+    for (size_t j = 0; j < estimate.alpha.size(); ++j) {
+        estimate.cL[j] /= weights[j];
+        estimate.cD[j] /= weights[j];
+    }
+
+    return !estimate.alpha.empty();
+}
+
+// Append a solved polar to the shape index file.
+// Each polar is written as: "SHAPE 1", the airfoil name, the signature values, "POLAR <Reynolds number> <number of points>
+// <settings>", then one "alpha CL CD" line per point. Older files may contain shapes with more than one polar
+void appendShapeIndex(const std::string& filename, const std::string& name, const std::vector<double>& signature, const StoredPolar& polar) {
+    std::ofstream outfile(filename, std::ios::app);
+    if (!outfile) {
+        std::cerr << "\nWarning: Could not save shape index to '" << filename << "'." << std::endl;
+        return;
+    }
+
+    outfile << std::setprecision(17);
+    outfile << "SHAPE 1\n" << name << "\n";
+    for (size_t i = 0; i < signature.size(); ++i) {
+        outfile << (i ? " " : "") << signature[i];
+    }
+    outfile << "\n";
+
+    outfile << "POLAR " << polar.reynolds << " " << polar.alpha.size() << " " << polar.settings << "\n";
+    for (size_t i = 0; i < polar.alpha.size(); ++i) {
+        outfile << polar.alpha[i] << " " << polar.cL[i] << " " << polar.cD[i] << "\n";
+    }
+}
+
+// Load the shape index from a file written by appendShapeIndex(), merging the polars of the same shape.
+// Blocks of the same shape are appended with the same signature text, so they are merged by exact signature
+// (later polars replacing the ones with the same inputs), and the tree is built only once at the end
+void loadShapeIndex(const std::string& filename) {
+    shapeIndex.clear();
+    vpTree.clear();
+    vpRoot = -1;
+    treeEntries = 0;
+    std::map<std::vector<double>, size_t> entryBySignature;
+
+    std::ifstream infile(filename);
+    std::string line;
+
+    while (std::getline(infile, line)) {
+        std::istringstream header(line);
+        std::string tag;
+        size_t numPolars = 0;
+        if (!(header >> tag >> numPolars) || tag != "SHAPE") {
+            continue;       // Skip unexpected lines
+        }
+
+        // Read airfoil name and signature
+        std::string name;
+        std::vector<double> signature;
+        std::getline(infile, name);
+        std::getline(infile, line);
+        std::istringstream values(line);
+        double value;
+        while (values >> value) {
+            signature.push_back(value);
+        }
+
+        // Read all the polars of the shape (the settings are the rest of the header line)
+        std::vector<StoredPolar> polars;
+        for (size_t p = 0; p < numPolars && std::getline(infile, line); ++p) {
+            std::istringstream polarHeader(line);
+            StoredPolar polar;
+            size_t numPoints = 0;
+            polarHeader >> tag >> polar.reynolds >> numPoints;
+            std::getline(polarHeader >> std::ws, polar.settings);
+
+            for (size_t i = 0; i < numPoints && std::getline(infile, line); ++i) {
+                std::istringstream ss(line);
+                double a, l, d;
+                if (ss >> a >> l >> d) {
+                    polar.alpha.push_back(a);
+                    polar.cL.push_back(l);
+                    polar.cD.push_back(d);
+                }
+            }
+            polars.push_back(polar);
+        }
+
+        if (signature.size() != static_cast<size_t>(2 * shapeStations)) {
+            continue;       // Signature computed with a different number of stations, cannot be compared
+        }
+
+        auto found = entryBySignature.find(signature);
+        if (found == entryBySignature.end()) {
+            found = entryBySignature.emplace(signature, shapeIndex.size()).first;
+            shapeIndex.push_back({name, signature, {}});
+        }
+        for (const auto& polar : polars) {
+            std::vector<StoredPolar>& stored = shapeIndex[found->second].polars;
+            auto same = std::find_if(stored.begin(), stored.end(), [&polar](const StoredPolar& other) {
+                return sameReynolds(other.reynolds, polar.reynolds) && other.settings == polar.settings;
+            });
+            if (same != stored.end()) {
+                *same = polar;      // Polar computed again with the same inputs
+            }
+            else {
+                stored.push_back(polar);
+            }
+        }
+    }
+
+    rebuildShapeTree();
+}
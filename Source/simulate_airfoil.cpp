@@ -6,47 +6,80 @@
 
     Xfoil is controlled through command-line inputs, and this function automates the process 
     of setting up and running the simulation.
+    The commands are compiled once as a script template (see xfoil_script.cpp) and sent in a single write.
+    Optionally, the surface distributions of every alpha are written too (see surface_data.cpp).
 */
 
 #include "../Header/simulate_airfoil.h"
 #include "../Header/control_xfoil.h"
+#include "../Header/xfoil_script.h"
 #include "../Header/config_settings.h"
+#include "../Header/surface_data.h"
 
 #include <iostream>
+#include <cstdio>
 
 // Define the output file name where simulation results will be saved
 std::string simDataFile = "sim_results.dat";    // File name to store simulation data
 
 // Function to run the airfoil simulation in xfoil.
-// This function sends a sequence of commands to xfoil to simulate an airfoil and store the results.
+// This function runs the simulation in the global xfoil process, using the parameters defined in config_settings.h
+// (capturing the surface distributions if requested from the command line)
 void runSimulation() {
-    // Enter operating mode in xfoil
-    sendCommandToXfoil("oper");     
+    std::string polarPath = "Output/" + simDataFile;
+    runSimulation(xfoil, reynoldsNumber, iterLimit, alphaStart, alphaEnd, alphaIncrement, polarPath,
+                  captureSurface ? surfaceFilesPrefix(polarPath) : "");
+}
 
-    // Enable viscous flow simulation mode
-    sendCommandToXfoil("visc");
+// Scripts running a viscous alpha sweep and saving the polar:
+//   oper                               Enter operating mode
+//   visc                               Enable viscous flow simulation mode
+//   re, <reynolds>                     Set Reynolds number
+//   iter <iterations>                  Set the iteration limit for each angle of attack
+//   pacc, (enter), (enter)             Start polar accumulation mode (for storing results), confirming twice
+//   aseq <first> <last> <step>         Angle of attack sweep from first to last alpha with the given increment
+//   pwrt, <polar>, y                   Write polar results to the given file, confirming overwrite if it already exists
+//   (enter)                            Go back to the main menu
+const XfoilScript sweepStartScript = compileXfoilScript(
+    "oper\nvisc\nre\n{re}\niter {iterations}\npacc\n\n\n", {"re", "iterations"});
+const XfoilScript sweepScript = compileXfoilScript("aseq {first} {last} {step}\n", {"first", "last", "step"});
+const XfoilScript polarScript = compileXfoilScript("pwrt\n{polar}\ny\n", {"polar"});
+const XfoilScript sweepEndScript = compileXfoilScript("\n", {});
 
-    // Set Reynolds number based on global variable (defined in config_settings.h)
-    sendCommandToXfoil("re");
-    sendCommandToXfoil(std::to_string(reynoldsNumber));     // Send the calculated Reynolds number to XFOIL
+// Xfoil only writes the surface distributions of the current solution. When they are captured, the polar is
+// written as soon as the sweep is completed (so it is exactly the one of a run without capture), then polar
+// accumulation is stopped and every alpha is solved again, from the last one down to the first one, so that each
+// solution starts from the converged solution of the next alpha, writing its surface files. The second solutions are
+// accumulated in a new polar, saved as they converge, so that surface files of diverged solutions can be left out:
+//   pacc                               Stop polar accumulation (the solutions below are not added to the sweep polar)
+//   pacc, <polar>, (enter)             Start a new polar accumulation, saved to the given file (without dump file)
+//   alfa <alpha>                       Solve again at the given angle of attack
+//   cpwr <cp file>                     Write the pressure coefficient along the surface
+//   dump <bl file>                     Write the boundary layer variables (Ue, displacement thickness, Cf, ...) along surface and wake
+const XfoilScript captureStartScript = compileXfoilScript("pacc\npacc\n{polar}\n\n", {"polar"});
+const XfoilScript captureScript = compileXfoilScript("alfa {alpha}\ncpwr {cp}\ndump {bl}\n", {"alpha", "cp", "bl"});
 
-    // Set the iteration limit for each angle of attack (alpha) during the simulation
-    sendCommandToXfoil("iter " + std::to_string(iterLimit));        // Iteration limit is defined in config_settings.h
+// Function to run the airfoil simulation in the given xfoil process.
+// The compiled scripts are rendered with the simulation parameters, then sent to xfoil in a single write
+void runSimulation(FILE* process, double reynolds, int iterations, double firstAlpha, double lastAlpha, double alphaStep,
+                   const std::string& polarPath, const std::string& surfacePrefix, int warmupPoints) {
+    thread_local std::string commands;      // Reused by every simulation run from this thread
+    renderXfoilScript(sweepStartScript, {formatScriptValue(reynolds), std::to_string(iterations)}, commands);
 
-    // Enter polar accumulation mode to store simulation results
-    sendCommandToXfoil("pacc");         // Start polar accumulation mode (for storing results)
-    sendCommandToXfoil("");             // Confirm to start accumulation (enter key)
-    sendCommandToXfoil("");             // Confirm once again (enter key)
+    appendXfoilScript(sweepScript, {formatScriptValue(firstAlpha - warmupPoints * alphaStep), formatScriptValue(lastAlpha),
+                                    formatScriptValue(alphaStep)}, commands);
+    appendXfoilScript(polarScript, {polarPath}, commands);
 
-    // Command to perform an angle of attack sweep from alphaStart to alphaEnd with a given increment
-    std::string angleSweepCommand = "aseq " + std::to_string(alphaStart) + " " + std::to_string(alphaEnd) + " " + std::to_string(alphaIncrement);
-    sendCommandToXfoil(angleSweepCommand.c_str());      // Send the AOA sweep command to xfoil
+    // Surface files of the alpha values of the sweep (not of the warm-up ones), in reverse order
+    if (!surfacePrefix.empty()) {
+        std::remove(surfacePolarPath(surfacePrefix).c_str());     // Xfoil would append to an existing polar file
+        appendXfoilScript(captureStartScript, {surfacePolarPath(surfacePrefix)}, commands);
+        for (size_t i = countSurfaceAlphas(firstAlpha, lastAlpha, alphaStep); i-- > 0; ) {
+            appendXfoilScript(captureScript, {formatScriptValue(firstAlpha + i * alphaStep), surfaceFilePath(surfacePrefix, i, "cp"),
+                                              surfaceFilePath(surfacePrefix, i, "bl")}, commands);
+        }
+    }
 
-    // Save the polar data (simulation results) into a file
-    sendCommandToXfoil("pwrt");         // Command to write polar results
-    sendCommandToXfoil("Output\\" + simDataFile);    // Specify the output file name
-    sendCommandToXfoil("y");            // Confirm overwrite if the file already exists
-
-    // Return to the XFOIL main menu
-    sendCommandToXfoil("");             // Go back to the main menu (enter key)
-}
\ No newline at end of file
+    appendXfoilScript(sweepEndScript, {}, commands);
+    sendScriptToXfoil(process, commands);
+}
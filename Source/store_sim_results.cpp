@@ -3,6 +3,9 @@
     from a file generated by xfoil. The function reads key values such as angle of attack (alpha), 
     lift coefficient (cL), and drag coefficient (cD), and then computes the efficiency (cL/cD) 
     for each alpha step. The data is stored in pre-allocated arrays for further analysis.
+
+    Reading a polar file is also available on its own, so that results of simulations run
+    outside of the interactive workflow (e.g. in parallel) can be loaded without global arrays.
 */
 
 #include "../Header/simulate_airfoil.h"
@@ -13,6 +16,7 @@
 #include <sstream>
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 // Calculate the number of steps in the alpha range (from alphaStart to alphaEnd)
 size_t numAlphaSteps = static_cast<size_t>((alphaEnd - alphaStart) / alphaIncrement) + 1;
@@ -24,17 +28,15 @@ std::vector<double> cL(numAlphaSteps);
 std::vector<double> cD(numAlphaSteps);
 std::vector<double> efficiency(numAlphaSteps);      // Efficiency is defined as cL/cD
 
-// Function to read simulation results from the output file generated by xfoil.
+// Function to read a polar file generated by xfoil.
 // The first 12 lines are skipped because they contain headers and metadata
-void storeSimulationResults() {
-    // Open the file that contains the simulation results
-    std::ifstream inputFile("Output/" + simDataFile);       // simDataFile is defined globally in simulate_airfoil.h
+bool readPolarFile(const std::string& filename, PolarResult& polar) {
+    polar = PolarResult();
 
-    // Check if the file was opened successfully
+    // Open the file that contains the simulation results
+    std::ifstream inputFile(filename);
     if (!inputFile.is_open()) {
-        // If the file couldn't be opened, print an error message and exit the program
-        std::cerr << "\nERROR: Could not open file '" << simDataFile << "'." << std::endl;
-        exit(1);
+        return false;
     }
 
     std::string line;           // Temporary string to store each line of the file
@@ -47,20 +49,16 @@ void storeSimulationResults() {
     }
 
     // Read the rest of the file, extracting data for each alpha step
-    size_t i = 0;       // Counter for storing values in the arrays
-
-    while (std::getline(inputFile, line) && i < numAlphaSteps) {
+    while (std::getline(inputFile, line)) {
         std::istringstream ss(line);                // Create a string stream to parse the line
         double alphaValue, cLValue, cDValue;        // Variables to store the parsed values
 
         // Parse alpha, cL, and cD from the line
         if (ss >> alphaValue >> cLValue >> cDValue) {
-            // Store the parsed values into the respective arrays
-            alpha[i] = alphaValue;                  // Store angle of attack (alpha)
-            cL[i] = cLValue;                        // Store lift coefficient (cL)
-            cD[i] = cDValue;                        // Store drag coefficient (cD)
-            efficiency[i] = cLValue / cDValue;      // Calculate and store efficiency (cL/cD)
-            i++;            // Move to the next index in the arrays
+            polar.alpha.push_back(alphaValue);              // Store angle of attack (alpha)
+            polar.cL.push_back(cLValue);                    // Store lift coefficient (cL)
+            polar.cD.push_back(cDValue);                    // Store drag coefficient (cD)
+            polar.efficiency.push_back(cLValue / cDValue);  // Calculate and store efficiency (cL/cD)
         } 
         else {
             // If parsing fails, print a warning message with the problematic line
@@ -68,16 +66,51 @@ void storeSimulationResults() {
         }
     }
 
-    // If no valid data was read, print an error message and exit the program
+    return true;
+}
+
+// Function to read simulation results from the output file generated by xfoil.
+// Errors are not fatal: the arrays are cleared and 0 is returned, so that the user can change the configuration and retry
+size_t storeSimulationResults() {
+    PolarResult polar;
+
+    // Read the file that contains the simulation results
+    if (!readPolarFile("Output/" + simDataFile, polar)) {     // simDataFile is defined globally in simulate_airfoil.h
+        // If the file couldn't be opened, print an error message
+        std::cerr << "\nERROR: Could not open file '" << simDataFile << "'." << std::endl;
+        return storePolarResults({}, {}, {});
+    }
+
+    size_t i = std::min(polar.alpha.size(), numAlphaSteps);     // Number of values read
+
+    // If no valid data was read, print an error message
     if (i == 0) {
         std::cerr << "\nERROR: Convergence failed for every alpha value." << std::endl;
-        exit(1);        // Exit the program if no valid results were obtained
+        return storePolarResults({}, {}, {});
     }
     // If fewer lines than expected were read, warn the user about convergence issues
     else if (i < numAlphaSteps) {
         std::cerr << "\nWarning: Convergence failed for " << (numAlphaSteps - i) <<" alpha value(s)." << std::endl; 
     }
 
-    // Close the input file after processing all lines
-    inputFile.close();
-}
\ No newline at end of file
+    // Store the values read in the global arrays
+    return storePolarResults(polar.alpha, polar.cL, polar.cD);
+}
+
+// Function to store the results of a polar already available in memory (e.g. reused from the shape index).
+// Values that do not fit in the arrays are discarded, and unused slots are reset to zero so that they are ignored
+size_t storePolarResults(const std::vector<double>& alphaValues, const std::vector<double>& cLValues, const std::vector<double>& cDValues) {
+    for (size_t i = 0; i < numAlphaSteps; ++i) {
+        if (i < alphaValues.size()) {
+            alpha[i] = alphaValues[i];                      // Store angle of attack (alpha)
+            cL[i] = cLValues[i];                            // Store lift coefficient (cL)
+            cD[i] = cDValues[i];                            // Store drag coefficient (cD)
+            efficiency[i] = cLValues[i] / cDValues[i];      // Calculate and store efficiency (cL/cD)
+        }
+        else {
+            alpha[i] = cL[i] = cD[i] = efficiency[i] = 0.0; // Reset unused slots
+        }
+    }
+
+    return std::min(alphaValues.size(), numAlphaSteps);
+}
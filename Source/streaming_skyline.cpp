@@ -0,0 +1,128 @@
+/*
+    This file implements an online Pareto front (skyline) of CL and L/D, used when the points to be screened
+    come from a stream too large to be stored (e.g. every airfoil of a library at every Reynolds number and alpha).
+
+    The front is kept in a map ordered by decreasing CL: since no point of the front can have both higher CL and
+    higher L/D than another, L/D increases along the map. This makes each insertion logarithmic:
+      - the new point is dominated if the point with the lowest CL not lower than its own has a higher (or equal) L/D
+      - otherwise, the points it dominates are the ones following it in the map, up to the first one with higher L/D
+    Only the points of the front are stored, so memory does not grow with the number of points offered.
+
+    The optimum is the point of the front with the highest L/D (the last one of the map). On a single polar this is
+    the point chosen by findOptimalConfig(): every point with lower alpha has both lower CL and lower L/D.
+    The front can be read (or written to a file, for dashboards) at any moment, also while other threads add points.
+*/
+
+#include "../Header/streaming_skyline.h"
+
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <cmath>
+
+// Offer a point to the skyline
+bool StreamingSkyline::insert(const SkylinePoint& point) {
+    std::lock_guard<std::mutex> guard(lock);
+    offered++;
+
+    // Skip points that did not converge or have invalid coefficients
+    if (!(point.cD > 0.0) || !std::isfinite(point.cL) || !std::isfinite(point.cD)) {
+        return false;
+    }
+    SkylinePoint candidate = point;
+    candidate.efficiency = point.cL / point.cD;
+
+    // The first point with CL not higher than the candidate (points before it have higher CL)
+    auto next = points.lower_bound(candidate.cL);
+
+    // Among the points with CL not lower than the candidate, the last one has the highest L/D
+    auto dominating = (next != points.end() && next->first == candidate.cL) ? next : points.end();
+    if (dominating == points.end() && next != points.begin()) {
+        dominating = std::prev(next);
+    }
+    if (dominating != points.end() && dominating->second.efficiency >= candidate.efficiency) {
+        return false;       // Dominated by a point already on the front
+    }
+
+    // Remove the points dominated by the candidate: lower (or equal) CL and lower (or equal) L/D
+    while (next != points.end() && next->second.efficiency <= candidate.efficiency) {
+        next = points.erase(next);
+    }
+
+    points.emplace_hint(next, candidate.cL, candidate);
+    return true;
+}
+
+// Get the current front, by decreasing CL
+std::vector<SkylinePoint> StreamingSkyline::front() const {
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<SkylinePoint> result;
+    result.reserve(points.size());
+    for (const auto& entry : points) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+// Get the current optimum: the point of the front with the highest L/D
+bool StreamingSkyline::optimum(SkylinePoint& point) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (points.empty()) {
+        return false;
+    }
+    point = points.rbegin()->second;
+    return true;
+}
+
+// Get the number of points on the current front
+size_t StreamingSkyline::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return points.size();
+}
+
+// Get the number of points offered so far (including the dominated ones)
+size_t StreamingSkyline::pointsOffered() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return offered;
+}
+
+// Remove all the points, to start a new screening
+void StreamingSkyline::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    points.clear();
+    offered = 0;
+}
+
+// Write the current front to a file. The file is written under a temporary name and then renamed,
+// so that programs reading it while a batch runs never see a partially written front
+bool StreamingSkyline::writeFront(const std::string& filename, const std::string& title) const {
+    std::vector<SkylinePoint> current = front();
+    size_t count = pointsOffered();
+
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream outfile(temporary);
+        if (!outfile) {
+            return false;
+        }
+
+        outfile << "\n--- " << title << " ---\n\n";
+        outfile << "Points screened: " << count << "\n";
+        outfile << "Front size: " << current.size() << "\n\n";
+        outfile << std::left << std::setw(36) << "Airfoil" << std::right << std::setw(12) << "Reynolds" << std::setw(10) << "Alpha"
+                << std::setw(10) << "CL" << std::setw(10) << "CD" << std::setw(10) << "L/D" << "\n";
+
+        outfile << std::fixed;
+        for (size_t i = 0; i < current.size(); ++i) {
+            const SkylinePoint& point = current[i];
+            outfile << std::left << std::setw(36) << point.source << std::right << std::setprecision(0) << std::setw(12)
+                    << point.reynolds << std::setprecision(3) << std::setw(10) << point.alpha << std::setw(10) << point.cL
+                    << std::setprecision(5) << std::setw(10) << point.cD << std::setprecision(3) << std::setw(10)
+                    << point.efficiency << (i + 1 == current.size() ? "   <- optimum" : "") << "\n";
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    return !error;
+}
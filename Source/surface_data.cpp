@@ -0,0 +1,514 @@
+/*
+    This file implements the capture and storage of the distributions along the airfoil surface
+    (pressure coefficient, skin friction, displacement thickness and transition locations), so that analyses
+    needing more than the integrated coefficients (e.g. structural loads or trailing-edge noise) can reuse the
+    solutions of the optimizer instead of running xfoil again.
+
+    When capture is enabled, xfoil writes the 'cpwr' and 'dump' files of every alpha next to the polar file.
+    Once xfoil is closed, the files of the converged alpha values are read, encoded and appended to
+    'surface_data.bin', then removed. The data file is a sequence of self-contained records:
+
+      file header:    "AFSD", uint32 version
+      record header:  uint32 record size, uint32 points, int64 Reynolds number, int32 alpha [millidegrees],
+                      uint32 name length, double upper transition, double lower transition  (40 bytes)
+      record data:    airfoil name, then the x, y, Cp, Cf and displacement thickness channels
+
+    Each channel is quantized to a fixed resolution and stored as differences between consecutive points
+    (zigzag varints): neighbouring points along the surface have close values, so most differences take one or
+    two bytes instead of eight. Integers are little-endian. A record interrupted by a crash is dropped the next
+    time the file is appended to, so that the following records stay readable.
+
+    The reader maps the file in memory and indexes the records by (airfoil, Reynolds number, alpha) when it is
+    opened, so each lookup decodes only the requested record, without reading the rest of the file.
+*/
+
+#include "../Header/surface_data.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <mutex>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Define the file where surface distributions are stored
+const std::string surfaceDataFile = "Output/surface_data.bin";
+
+const char surfaceMagic[4] = {'A', 'F', 'S', 'D'};     // First bytes of the data file
+const uint32_t surfaceVersion = 1;                      // Version of the record format
+const size_t fileHeaderSize = 8;                        // Magic and version
+const size_t recordHeaderSize = 40;                     // Fixed fields of each record
+
+// Resolution of the quantized channels, in the same order in which they are stored
+const double channelResolution[5] = {1.0e-6,      // x  [fraction of chord]
+                                     1.0e-6,      // y  [fraction of chord]
+                                     1.0e-5,      // Cp
+                                     1.0e-7,      // Cf
+                                     1.0e-7};     // Displacement thickness  [fraction of chord]
+
+std::mutex surfaceFileLock;     // Serializes the appends of parallel simulations
+
+// Get the prefix of the surface files written next to a polar file
+std::string surfaceFilesPrefix(const std::string& polarPath) {
+    return polarPath.substr(0, polarPath.rfind('.')) + "_surface";
+}
+
+// Get the path of a surface file of the alpha with the given index
+std::string surfaceFilePath(const std::string& prefix, size_t index, const std::string& type) {
+    return prefix + "_" + std::to_string(index) + "_" + type + ".dat";
+}
+
+// Get the path of the polar accumulated while the surface files are written
+std::string surfacePolarPath(const std::string& prefix) {
+    return prefix + "_polar.dat";
+}
+
+// Get the number of alpha values of a sweep
+size_t countSurfaceAlphas(double firstAlpha, double lastAlpha, double alphaStep) {
+    long count = alphaStep != 0.0 ? std::lround((lastAlpha - firstAlpha) / alphaStep) + 1 : 1;
+    return count < 1 ? 1 : static_cast<size_t>(count);
+}
+
+// Helper function to remove the spaces around an airfoil name, so that names read from files match the ones typed by users
+std::string trimAirfoilName(const std::string& name) {
+    size_t first = name.find_first_not_of(" \t\r\n");
+    size_t last = name.find_last_not_of(" \t\r\n");
+    return first == std::string::npos ? "" : name.substr(first, last - first + 1);
+}
+
+// Helper functions to write fixed-size little-endian values and varints
+void putFixed(std::string& out, uint64_t value, int bytes) {
+    for (int b = 0; b < bytes; ++b) {
+        out.push_back(static_cast<char>((value >> (8 * b)) & 0xFF));
+    }
+}
+
+void putDouble(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putFixed(out, bits, 8);
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Helper functions to read the values written above (the caller checks that fixed-size values are inside the data)
+uint64_t getFixed(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int b = 0; b < bytes; ++b) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[b])) << (8 * b);
+    }
+    return value;
+}
+
+double getDouble(const char* data) {
+    uint64_t bits = getFixed(data, 8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool getVarint(const char* data, size_t end, size_t& position, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && position < end; shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(data[position++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;       // Truncated or corrupted value
+}
+
+// Helper function to get the key of a solution: Reynolds number and alpha are rounded, so that values read back
+// from text files (or typed by users) match the stored ones
+std::tuple<std::string, int64_t, int32_t> surfaceKey(const std::string& airfoil, double reynolds, double alpha) {
+    return std::make_tuple(trimAirfoilName(airfoil), static_cast<int64_t>(std::llround(reynolds)),
+                           static_cast<int32_t>(std::lround(alpha * 1000.0)));
+}
+
+// Encode a distribution as a record of the data file
+std::string encodeSurfaceRecord(const SurfaceDistribution& distribution) {
+    std::string name = trimAirfoilName(distribution.airfoil);
+    auto key = surfaceKey(name, distribution.reynolds, distribution.alpha);
+    size_t points = distribution.x.size();
+
+    std::string record;
+    putFixed(record, 0, 4);         // Record size, written once known
+    putFixed(record, points, 4);
+    putFixed(record, static_cast<uint64_t>(std::get<1>(key)), 8);
+    putFixed(record, static_cast<uint32_t>(std::get<2>(key)), 4);
+    putFixed(record, name.size(), 4);
+    putDouble(record, distribution.xtrTop);
+    putDouble(record, distribution.xtrBottom);
+    record += name;
+
+    // Quantize each channel and store the zigzag-encoded differences between consecutive points
+    const std::vector<double>* channels[5] = {&distribution.x, &distribution.y, &distribution.cp, &distribution.cf, &distribution.dstar};
+    for (int c = 0; c < 5; ++c) {
+        int64_t previous = 0;
+        for (size_t i = 0; i < points; ++i) {
+            double value = i < channels[c]->size() ? (*channels[c])[i] : 0.0;
+            int64_t quantized = std::isfinite(value) ? std::llround(value / channelResolution[c]) : 0;
+            int64_t delta = quantized - previous;
+            putVarint(record, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+            previous = quantized;
+        }
+    }
+
+    std::string size;
+    putFixed(size, record.size(), 4);
+    record.replace(0, 4, size);
+    return record;
+}
+
+// Helper function to decode the record at the given offset (false if it is corrupted)
+bool decodeSurfaceRecord(const char* data, size_t offset, SurfaceDistribution& distribution) {
+    const char* record = data + offset;
+    size_t size = getFixed(record, 4);
+    size_t points = getFixed(record + 4, 4);
+    size_t nameLength = getFixed(record + 20, 4);
+
+    distribution = SurfaceDistribution();
+    distribution.reynolds = static_cast<double>(static_cast<int64_t>(getFixed(record + 8, 8)));
+    distribution.alpha = static_cast<int32_t>(getFixed(record + 16, 4)) / 1000.0;
+    distribution.xtrTop = getDouble(record + 24);
+    distribution.xtrBottom = getDouble(record + 32);
+    distribution.airfoil.assign(record + recordHeaderSize, nameLength);
+
+    std::vector<double>* channels[5] = {&distribution.x, &distribution.y, &distribution.cp, &distribution.cf, &distribution.dstar};
+    size_t position = recordHeaderSize + nameLength;
+    for (int c = 0; c < 5; ++c) {
+        channels[c]->reserve(points);
+        int64_t previous = 0;
+        for (size_t i = 0; i < points; ++i) {
+            uint64_t zigzag;
+            if (!getVarint(record, size, position, zigzag)) {
+                return false;
+            }
+            previous += static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            channels[c]->push_back(previous * channelResolution[c]);
+        }
+    }
+    return true;
+}
+
+// Helper function to check the file header
+bool validFileHeader(const char* header) {
+    return std::memcmp(header, surfaceMagic, 4) == 0 && getFixed(header + 4, 4) == surfaceVersion;
+}
+
+// Helper function to get the size of the record with the given header, starting at the given offset of a file with
+// the given length (0 if the record was interrupted while being written)
+size_t recordSize(const char* header, size_t offset, size_t length) {
+    size_t size = getFixed(header, 4);
+    size_t nameLength = getFixed(header + 20, 4);
+    return (size < recordHeaderSize + nameLength || size > length - offset) ? 0 : size;
+}
+
+// Helper function to read the numbers of a line (comment and header lines give no numbers)
+std::vector<double> readNumbers(const std::string& line) {
+    std::vector<double> numbers;
+    std::istringstream ss(line);
+    double value;
+    while (ss >> value) {
+        numbers.push_back(value);
+    }
+    return numbers;
+}
+
+// Helper function to read the rows of a surface file with at least the given number of columns
+std::vector<std::vector<double>> readSurfaceFile(const std::string& filename, size_t columns) {
+    std::vector<std::vector<double>> rows;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::vector<double> numbers = readNumbers(line);
+        if (numbers.size() >= columns) {
+            rows.push_back(numbers);
+        }
+    }
+    return rows;
+}
+
+// Helper function to read the rows of a polar file written by xfoil
+// (columns: alpha, CL, CD, CDp, CM, upper transition, lower transition, after 12 header lines)
+std::vector<std::vector<double>> readPolarRows(const std::string& filename) {
+    std::vector<std::vector<double>> rows;
+    std::ifstream file(filename);
+    std::string line;
+    for (int i = 0; i < 12 && std::getline(file, line); ++i) {
+    }
+
+    while (std::getline(file, line)) {
+        std::vector<double> row = readNumbers(line);
+        if (row.size() >= 7) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+// Read the surface files of a sweep and encode the distributions of the converged alpha values
+std::string collectSurfaceRecords(const std::string& airfoil, double reynolds, const std::string& prefix,
+                                  double firstAlpha, double lastAlpha, double alphaStep, const std::string& polarPath) {
+    std::string records;
+    size_t count = countSurfaceAlphas(firstAlpha, lastAlpha, alphaStep);
+
+    // Step 1: Find the alpha values whose second solution (the one written to the surface files) converged too.
+    // The sweep polar gives the transition locations, the polar of the second solutions only tells which ones converged
+    std::vector<bool> captured(count, false);
+    for (const std::vector<double>& row : readPolarRows(surfacePolarPath(prefix))) {
+        long index = alphaStep != 0.0 ? std::lround((row[0] - firstAlpha) / alphaStep) : 0;
+        if (index >= 0 && static_cast<size_t>(index) < count && std::fabs(firstAlpha + index * alphaStep - row[0]) <= 1e-3) {
+            captured[index] = true;
+        }
+    }
+
+    for (const std::vector<double>& row : readPolarRows(polarPath)) {
+        // Find the index of this alpha in the sweep (alpha is written by xfoil with 3 decimals)
+        long index = alphaStep != 0.0 ? std::lround((row[0] - firstAlpha) / alphaStep) : 0;
+        if (index < 0 || static_cast<size_t>(index) >= count || std::fabs(firstAlpha + index * alphaStep - row[0]) > 1e-3) {
+            continue;
+        }
+        if (!captured[index]) {
+            std::cerr << "\nWarning: Surface data of '" << airfoil << "' at alpha " << row[0] << " did not converge." << std::endl;
+            continue;
+        }
+
+        // Step 2: Read the pressure coefficient (last column, whatever the xfoil version) and the boundary layer
+        // variables (s, x, y, Ue, displacement thickness, momentum thickness, Cf, ...). The boundary layer file
+        // continues with the wake, so only its first rows (one for each surface point) are used
+        std::vector<std::vector<double>> cpRows = readSurfaceFile(surfaceFilePath(prefix, index, "cp"), 2);
+        std::vector<std::vector<double>> blRows = readSurfaceFile(surfaceFilePath(prefix, index, "bl"), 7);
+        if (cpRows.empty() || blRows.size() < cpRows.size()) {
+            std::cerr << "\nWarning: Surface data missing for '" << airfoil << "' at alpha " << row[0] << "." << std::endl;
+            continue;
+        }
+
+        SurfaceDistribution distribution = {airfoil, reynolds, row[0], row[5], row[6], {}, {}, {}, {}, {}};
+        for (size_t i = 0; i < cpRows.size(); ++i) {
+            distribution.x.push_back(blRows[i][1]);
+            distribution.y.push_back(blRows[i][2]);
+            distribution.cp.push_back(cpRows[i].back());
+            distribution.cf.push_back(blRows[i][6]);
+            distribution.dstar.push_back(blRows[i][4]);
+        }
+        records += encodeSurfaceRecord(distribution);
+    }
+
+    // Step 3: Remove the surface files of every alpha (including the ones that did not converge) and their polar
+    for (size_t i = 0; i < count; ++i) {
+        std::remove(surfaceFilePath(prefix, i, "cp").c_str());
+        std::remove(surfaceFilePath(prefix, i, "bl").c_str());
+    }
+    std::remove(surfacePolarPath(prefix).c_str());
+
+    return records;
+}
+
+// Append encoded records to the data file
+bool appendSurfaceRecords(const std::string& records) {
+    std::lock_guard<std::mutex> guard(surfaceFileLock);
+    static bool checked = false;        // The end of the file is checked once, before the first append
+
+    std::error_code error;
+    uintmax_t length = std::filesystem::file_size(surfaceDataFile, error);
+    if (error) {
+        length = 0;
+    }
+
+    // Drop a record interrupted by a crash of a previous run (or start again if the header is not valid),
+    // otherwise the records appended after it could not be found. Only the record headers are read
+    if (!checked && length > 0) {
+        std::ifstream file(surfaceDataFile, std::ios::binary);
+        char header[recordHeaderSize];
+        size_t valid = 0;
+        if (file.read(header, fileHeaderSize) && validFileHeader(header)) {
+            valid = fileHeaderSize;
+            while (valid + recordHeaderSize <= length && file.seekg(valid) && file.read(header, recordHeaderSize)) {
+                size_t size = recordSize(header, valid, length);
+                if (size == 0) {
+                    break;
+                }
+                valid += size;
+            }
+        }
+        file.close();
+
+        if (valid < length) {
+            std::cerr << "\nWarning: Dropped " << (length - valid) << " damaged bytes at the end of '" << surfaceDataFile << "'." << std::endl;
+            std::filesystem::resize_file(surfaceDataFile, valid, error);
+            length = valid;
+        }
+    }
+    checked = true;
+
+    if (records.empty()) {
+        return true;
+    }
+
+    std::ofstream file(surfaceDataFile, std::ios::binary | std::ios::app);
+    if (!file) {
+        std::cerr << "\nERROR: Could not open '" << surfaceDataFile << "'." << std::endl;
+        return false;
+    }
+    if (length == 0) {
+        std::string header(surfaceMagic, 4);
+        putFixed(header, surfaceVersion, 4);
+        file.write(header.data(), header.size());
+    }
+    file.write(records.data(), records.size());
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+// Print the distribution stored for the given airfoil, Reynolds number and alpha
+bool showSurfaceDistribution(const std::string& airfoil, double reynolds, double alpha) {
+    SurfaceDataReader reader;
+    SurfaceDistribution distribution;
+    if (!reader.open(surfaceDataFile) || !reader.find(airfoil, reynolds, alpha, distribution)) {
+        return false;
+    }
+
+    std::cout << "\n--- SURFACE DISTRIBUTION ---\n\n";
+    std::cout << "Airfoil model: " << distribution.airfoil << "\n";
+    std::cout << "Reynolds number: " << std::fixed << std::setprecision(0) << distribution.reynolds << "\n";
+    std::cout << "Alpha: " << std::setprecision(3) << distribution.alpha << " deg\n";
+    std::cout << "Transition (x/c): upper " << std::setprecision(4) << distribution.xtrTop
+              << ", lower " << distribution.xtrBottom << "\n\n";
+    std::cout << std::setw(10) << "x" << std::setw(10) << "y" << std::setw(10) << "Cp"
+              << std::setw(12) << "Cf" << std::setw(12) << "Dstar" << "\n";
+    for (size_t i = 0; i < distribution.x.size(); ++i) {
+        std::cout << std::setprecision(5) << std::setw(10) << distribution.x[i] << std::setw(10) << distribution.y[i]
+                  << std::setprecision(4) << std::setw(10) << distribution.cp[i] << std::setprecision(6)
+                  << std::setw(12) << distribution.cf[i] << std::setw(12) << distribution.dstar[i] << "\n";
+    }
+    std::cout << std::defaultfloat << std::flush;
+    return true;
+}
+
+SurfaceDataReader::SurfaceDataReader() : data(nullptr), length(0), mapping(nullptr) {}
+
+SurfaceDataReader::~SurfaceDataReader() {
+    close();
+}
+
+// Map the file in memory (or read it, if it cannot be mapped) and index its records
+bool SurfaceDataReader::open(const std::string& filename) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            HANDLE handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void* view = handle ? MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (view) {
+                mapping = handle;
+                data = static_cast<const char*>(view);
+                length = static_cast<size_t>(size.QuadPart);
+            }
+            else if (handle) {
+                CloseHandle(handle);
+            }
+        }
+        CloseHandle(file);      // The mapping keeps the file open
+    }
+#else
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file >= 0) {
+        struct stat status;
+        if (fstat(file, &status) == 0 && status.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (view != MAP_FAILED) {
+                mapping = view;
+                data = static_cast<const char*>(view);
+                length = static_cast<size_t>(status.st_size);
+            }
+        }
+        ::close(file);          // The mapping keeps the file open
+    }
+#endif
+
+    if (!mapping) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = copy.data();
+        length = copy.size();
+    }
+
+    // Index the records: a solution stored more than once (e.g. simulated again) is read from the last record
+    bool valid = length >= fileHeaderSize && validFileHeader(data);
+    for (size_t offset = fileHeaderSize; valid && offset + recordHeaderSize <= length;) {
+        const char* record = data + offset;
+        size_t size = recordSize(record, offset, length);
+        if (size == 0) {
+            break;      // Record interrupted while being written: the rest of the file is ignored
+        }
+        std::string name(record + recordHeaderSize, getFixed(record + 20, 4));
+        index[std::make_tuple(name, static_cast<int64_t>(getFixed(record + 8, 8)), static_cast<int32_t>(getFixed(record + 16, 4)))] = offset;
+        offset += size;
+    }
+
+    if (!valid) {
+        close();
+    }
+    return valid;
+}
+
+// Unmap the file and clear the index
+void SurfaceDataReader::close() {
+#ifdef _WIN32
+    if (mapping) {
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mapping));
+    }
+#else
+    if (mapping) {
+        munmap(mapping, length);
+    }
+#endif
+    mapping = nullptr;
+    data = nullptr;
+    length = 0;
+    copy.clear();
+    index.clear();
+}
+
+// Find the distribution of the given solution, decoding only its record
+bool SurfaceDataReader::find(const std::string& airfoil, double reynolds, double alpha, SurfaceDistribution& distribution) const {
+    auto entry = index.find(surfaceKey(airfoil, reynolds, alpha));
+    return entry != index.end() && decodeSurfaceRecord(data, entry->second, distribution);
+}
+
+// Get the number of solutions stored
+size_t SurfaceDataReader::size() const {
+    return index.size();
+}
@@ -0,0 +1,88 @@
+/*
+    This file implements compiled XFOIL command scripts. Every simulation sends xfoil the same sequence of
+    commands (load the airfoil, set the panel nodes, set viscous mode and Reynolds number, run the alpha sweep
+    and write the polar), changing only a few values. Instead of building and sending the commands one line at
+    a time, the sequence is written once as a template with placeholders (e.g. "re\n{re}\n"), compiled when the
+    program starts, and then rendered for each run by inserting the values into a reusable buffer.
+
+    The rendered commands are sent with a single write into the buffer of the pipe. Xfoil reads its commands
+    in order and the program never waits for an answer while a session is open (results are read from the
+    polar file only after xfoil has been closed), so no flush is needed between commands: the whole session
+    reaches xfoil in one system call when the pipe is flushed or closed.
+*/
+
+#include "../Header/xfoil_script.h"
+
+#include <iostream>
+#include <cstdlib>
+
+// Compile a script template, splitting its text around the placeholders.
+// Scripts are compiled while the program starts (before main), so a template using a name missing from the list
+// is a programming error, reported before any command can reach xfoil
+XfoilScript compileXfoilScript(const std::string& source, const std::vector<std::string>& names) {
+    XfoilScript script;
+    std::string text;
+    size_t position = 0;
+
+    while (position < source.size()) {
+        size_t open = source.find('{', position);
+        size_t close = open == std::string::npos ? std::string::npos : source.find('}', open);
+        if (close == std::string::npos) {
+            text += source.substr(position);        // No more placeholders
+            break;
+        }
+
+        // Find the value replacing the placeholder
+        std::string name = source.substr(open + 1, close - open - 1);
+        size_t slot = 0;
+        while (slot < names.size() && names[slot] != name) {
+            slot++;
+        }
+        if (slot == names.size()) {
+            std::cerr << "ERROR: Unknown placeholder '{" << name << "}' in xfoil script." << std::endl;
+            exit(1);
+        }
+
+        script.text.push_back(text + source.substr(position, open - position));
+        script.slots.push_back(slot);
+        text.clear();
+        position = close + 1;
+    }
+
+    script.text.push_back(text);
+    return script;
+}
+
+// Write the commands of a compiled script into the buffer, inserting the given values
+void renderXfoilScript(const XfoilScript& script, const std::vector<std::string>& values, std::string& commands) {
+    commands.clear();
+    appendXfoilScript(script, values, commands);
+}
+
+// Append the commands of a compiled script to the buffer, inserting the given values
+void appendXfoilScript(const XfoilScript& script, const std::vector<std::string>& values, std::string& commands) {
+    for (size_t i = 0; i < script.slots.size(); ++i) {
+        commands += script.text[i];
+        commands += values[script.slots[i]];
+    }
+    commands += script.text.back();
+}
+
+// Send a block of commands to the given xfoil process with a single buffered write
+void sendScriptToXfoil(FILE* process, const std::string& commands) {
+    if (process) {    // Check if xfoil is open
+        fwrite(commands.data(), 1, commands.size(), process);
+    }
+    else {
+        // If xfoil is not open, print an error message
+        std::cerr << "Error: xfoil is not open" << std::endl;
+        exit(1);
+    }
+}
+
+// Format a value to be inserted in a script
+std::string formatScriptValue(double value) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%f", value);
+    return buffer;
+}